@@ -2882,6 +2882,12 @@ class USERPREF_PT_experimental_new_features(ExperimentalPanel, Panel):
                 ({"property": "use_new_volume_nodes"}, ("blender/blender/issues/103248", "#103248")),
                 ({"property": "use_new_file_import_nodes"}, ("blender/blender/issues/122846", "#122846")),
                 ({"property": "use_shader_node_previews"}, ("blender/blender/issues/110353", "#110353")),
+                ({"property": "use_mmap_shared_data"}, None),
+                ({"property": "use_undo_skip_unchanged_ids"}, None),
+                ({"property": "use_undo_async_push"}, None),
+                ({"property": "use_undo_compression"}, None),
+                ({"property": "use_depsgraph_incremental_relations"}, None),
+                ({"property": "use_blend_file_index"}, None),
             ),
         )
 
@@ -2933,6 +2939,7 @@ class USERPREF_PT_experimental_debugging(ExperimentalPanel, Panel):
                 ({"property": "override_auto_resync"}, ("blender/blender/issues/83811", "#83811")),
                 ({"property": "use_all_linked_data_direct"}, None),
                 ({"property": "use_recompute_usercount_on_save_debug"}, None),
+                ({"property": "no_geometry_nodes_memoization"}, None),
                 ({"property": "use_cycles_debug"}, None),
                 ({"property": "show_asset_debug_info"}, None),
                 ({"property": "use_asset_indexing"}, None),
@@ -272,6 +272,14 @@ bool BKE_animsys_rna_path_resolve(struct PointerRNA *ptr,
                                   const char *rna_path,
                                   int array_index,
                                   struct PathResolvedRNA *r_result);
+/**
+ * Resolve another \a array_index of a property already found by #BKE_animsys_rna_path_resolve,
+ * without looking up its RNA path again.
+ * \note \a path_result and \a r_result may point to the same struct.
+ */
+bool BKE_animsys_rna_path_resolve_array_index(const struct PathResolvedRNA *path_result,
+                                              int array_index,
+                                              struct PathResolvedRNA *r_result);
 bool BKE_animsys_read_from_rna_path(struct PathResolvedRNA *anim_rna, float *r_value);
 /**
  * Write the given value to a setting using RNA, and return success.
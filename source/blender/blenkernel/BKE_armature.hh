@@ -373,6 +373,12 @@ void BKE_pchan_calc_mat(bPoseChannel *pchan);
  */
 void BKE_bone_offset_matrix_get(const Bone *bone, float offs_bone[4][4]);
 
+/**
+ * Compute the inverse of the rest matrix of a bone (#Bone.arm_mat). Rest matrices only contain a
+ * rotation and a translation, so this is much cheaper than a general 4x4 matrix inverse.
+ */
+void BKE_bone_arm_mat_invert(const Bone *bone, float r_arm_mat_inv[4][4]);
+
 /* Transformation inherited from the parent bone. These matrices apply the effects of
  * HINGE/NO_SCALE/NO_LOCAL_LOCATION options over the pchan loc/rot/scale transformations. */
 struct BoneParentTransform {
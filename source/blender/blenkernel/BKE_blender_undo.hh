@@ -15,7 +15,21 @@ struct bContext;
 
 #define BKE_UNDO_STR_MAX 64
 
-MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev);
+/**
+ * \param use_deferred_write: Allow leaving part of the writing to
+ * #BKE_memfile_undo_encode_deferred, which is then needed when #MemFile.deferred_write is set.
+ */
+MemFileUndoData *BKE_memfile_undo_encode(Main *bmain,
+                                         MemFileUndoData *mfu_prev,
+                                         bool use_deferred_write);
+/**
+ * Finish writing an undo step encoded with deferred writing. Can run in a worker thread.
+ */
+void BKE_memfile_undo_encode_deferred(MemFileUndoData *mfu);
+/**
+ * Free the data kept for #BKE_memfile_undo_encode_deferred once it is done. Main thread only.
+ */
+void BKE_memfile_undo_encode_deferred_end(MemFileUndoData *mfu);
 bool BKE_memfile_undo_decode(MemFileUndoData *mfu,
                              eUndoStepDir undo_direction,
                              bool use_old_bmain_data,
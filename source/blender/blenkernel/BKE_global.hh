@@ -43,6 +43,11 @@ struct Global {
   char filepath_last_image[/*FILE_MAX*/ 1024];
   /** Last used location for library link/append. */
   char filepath_last_library[/*FILE_MAX*/ 1024];
+  /**
+   * Statistics about geometry nodes evaluation are written to this file on exit when set.
+   * Set via `--profile-geometry-nodes` command line argument.
+   */
+  char filepath_geometry_nodes_profile[/*FILE_MAX*/ 1024];
 
   /**
    * Strings of recently opened files to show in the file menu.
@@ -257,8 +262,9 @@ enum {
   G_DEBUG_DEPSGRAPH_PRETTY = (1 << 13),     /* use pretty colors in depsgraph messages */
   G_DEBUG_DEPSGRAPH_UID = (1 << 14),        /* Verify validness of session-wide identifiers
                                              * assigned to ID datablocks */
+  G_DEBUG_DEPSGRAPH_MEMORY = (1 << 25),     /* depsgraph evaluated data memory statistics */
   G_DEBUG_DEPSGRAPH = (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_EVAL | G_DEBUG_DEPSGRAPH_TAG |
-                       G_DEBUG_DEPSGRAPH_TIME | G_DEBUG_DEPSGRAPH_UID),
+                       G_DEBUG_DEPSGRAPH_TIME | G_DEBUG_DEPSGRAPH_UID | G_DEBUG_DEPSGRAPH_MEMORY),
   G_DEBUG_SIMDATA = (1 << 15),               /* sim debug data display */
   G_DEBUG_GPU = (1 << 16),                   /* gpu debug */
   G_DEBUG_IO = (1 << 17),                    /* IO Debugging (for Collada, ...). */
@@ -62,6 +62,24 @@ enum {
    * IDs have at least an 'extra user' (#ID_TAG_EXTRAUSER).
    */
   IDTYPE_FLAGS_NEVER_UNUSED = 1 << 6,
+  /**
+   * Indicates that #IDTypeInfo.blend_write can be called concurrently for different IDs of this
+   * type, i.e. it only reads its own ID data and does not modify any shared state.
+   *
+   * This allows writing these IDs in parallel when saving a blend-file.
+   */
+  IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE = 1 << 7,
+  /**
+   * Indicates that all changes to IDs of this type are tagged through the depsgraph (accumulated
+   * in #ID.recalc_after_undo_push), and that they have no embedded IDs.
+   *
+   * This allows memfile undo to reuse the data stored for these IDs in the previous undo step
+   * when they were not tagged since then, instead of writing them again.
+   *
+   * \note Meshes don't have this flag, sculpt and paint modes modify them in place while only
+   * tagging the object.
+   */
+  IDTYPE_FLAGS_UNDO_CHANGES_ARE_TAGGED = 1 << 8,
 };
 
 struct IDCacheKey {
@@ -393,6 +393,12 @@ struct bNodeType {
 
   /** True when the node cannot be muted. */
   bool no_muting;
+  /**
+   * True when the outputs of the geometry node only depend on its inputs and settings, so that
+   * they can be reused from the memory cache when the node is evaluated with the same inputs
+   * again. This is only worth it for nodes that are expensive compared to copying their outputs.
+   */
+  bool geometry_node_memoize;
   /** True when the node still works but it's usage is discouraged. */
   const char *deprecation_notice;
 
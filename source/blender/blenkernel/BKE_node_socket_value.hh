@@ -121,6 +121,11 @@ class SocketValueVariant {
    */
   bool is_context_dependent_field() const;
 
+  /**
+   * The stored value is a single value, i.e. not a field or grid.
+   */
+  bool is_single() const;
+
   /**
    * The stored value is a volume grid.
    */
@@ -13,6 +13,7 @@
 #include "DNA_listBase.h"
 
 struct Main;
+struct UndoStackEncodeAsync;
 struct UndoStep;
 struct UndoType;
 struct bContext;
@@ -67,6 +68,10 @@ struct UndoStack {
    * within which all but the last undo-step is marked for skipping.
    */
   int group_level;
+  /**
+   * Step being encoded in the background, see #UndoType.step_encode_async.
+   */
+  UndoStackEncodeAsync *encode_async;
 };
 
 struct UndoStep {
@@ -84,6 +89,9 @@ struct UndoStep {
   bool use_old_bmain_data;
   /** For use by undo systems that accumulate changes (mesh-sculpt & image-painting). */
   bool is_applied;
+  /** Set by #UndoType.step_encode when the encoding has to be finished by
+   * #UndoType.step_encode_async. */
+  bool use_encode_async;
   /* Over alloc 'type->struct_size'. */
 };
 
@@ -124,6 +132,19 @@ struct UndoType {
   void (*step_encode_init)(bContext *C, UndoStep *us);
 
   bool (*step_encode)(bContext *C, Main *bmain, UndoStep *us);
+  /**
+   * Optional, finish encoding the step in a worker thread when #UndoStep.use_encode_async was set
+   * by 'step_encode'. It must not access Main, and returns the final #UndoStep.data_size.
+   *
+   * The undo system waits for it before decoding any step, pushing a new one or freeing this
+   * step or the previous step of the same type.
+   */
+  size_t (*step_encode_async)(UndoStep *us);
+  /**
+   * Optional, called from the main thread once 'step_encode_async' is done, to free data that
+   * can't be freed from a worker thread.
+   */
+  void (*step_encode_async_end)(UndoStep *us);
   void (*step_decode)(bContext *C, Main *bmain, UndoStep *us, eUndoStepDir dir, bool is_final);
 
   /**
@@ -137,6 +158,13 @@ struct UndoType {
                               UndoTypeForEachIDRefFn foreach_ID_ref_fn,
                               void *user_data);
 
+  /**
+   * Optional, reduce the memory used by the steps of this type which are not adjacent to the
+   * active step (e.g. by compressing them), updating their #UndoStep.data_size.
+   * Called by #BKE_undosys_stack_limit_steps_and_memory before freeing steps.
+   */
+  void (*stack_compress)(UndoStack *ustack);
+
   /** Information for the generic undo system to refine handling of this specific undo type. */
   uint flags;
 
@@ -181,6 +209,10 @@ extern const UndoType *BKE_UNDOSYS_TYPE_TEXT;
 
 UndoStack *BKE_undosys_stack_create();
 void BKE_undosys_stack_destroy(UndoStack *ustack);
+/**
+ * Wait for the step being encoded in the background to be complete, if any.
+ */
+void BKE_undosys_stack_encode_async_wait(UndoStack *ustack);
 void BKE_undosys_stack_clear(UndoStack *ustack);
 void BKE_undosys_stack_clear_active(UndoStack *ustack);
 /* name optional */
@@ -192,7 +224,9 @@ UndoStep *BKE_undosys_stack_active_with_type(UndoStack *ustack, const UndoType *
 UndoStep *BKE_undosys_stack_init_or_active_with_type(UndoStack *ustack, const UndoType *ut);
 /**
  * \param steps: Limit the number of undo steps.
- * \param memory_limit: Limit the amount of memory used by the undo stack.
+ * \param memory_limit: Limit the amount of memory used by the undo stack. Undo types which
+ * support it are first asked to compress their steps (see #UndoType.stack_compress), steps are
+ * only freed when this isn't enough.
  */
 void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size_t memory_limit);
 #define BKE_undosys_stack_limit_steps_and_memory_defaults(ustack) \
@@ -376,23 +376,69 @@ bool BKE_animsys_rna_path_resolve(
     return false;
   }
 
-  int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
-  if (array_len && array_index >= array_len) {
+  if (!BKE_animsys_rna_path_resolve_array_index(r_result, array_index, r_result)) {
     if (G.debug & G_DEBUG) {
       CLOG_WARN(&LOG,
                 "Animato: Invalid array index. ID = '%s',  '%s[%d]', array length is %d",
                 (ptr->owner_id) ? (ptr->owner_id->name + 2) : "<No ID>",
                 path,
                 array_index,
-                array_len - 1);
+                RNA_property_array_length(&r_result->ptr, r_result->prop) - 1);
     }
     return false;
   }
 
+  return true;
+}
+
+bool BKE_animsys_rna_path_resolve_array_index(const PathResolvedRNA *path_result,
+                                              const int array_index,
+                                              PathResolvedRNA *r_result)
+{
+  PointerRNA ptr = path_result->ptr;
+  const int array_len = RNA_property_array_length(&ptr, path_result->prop);
+  if (array_len && array_index >= array_len) {
+    return false;
+  }
+
+  *r_result = *path_result;
   r_result->prop_index = array_len ? array_index : -1;
   return true;
 }
 
+/**
+ * Resolves the RNA paths of a sequence of F-Curves, only looking up the property again when the
+ * RNA path changes. The F-Curves of the channels of one property (e.g. X, Y and Z location) are
+ * stored next to each other, so this avoids most of the RNA path parsing when evaluating an
+ * Action.
+ */
+class AnimsysPathResolver {
+  PointerRNA *ptr_;
+  /** RNA path of #path_result_, nullptr when the last look-up failed. */
+  const char *rna_path_ = nullptr;
+  PathResolvedRNA path_result_;
+
+ public:
+  explicit AnimsysPathResolver(PointerRNA *ptr) : ptr_(ptr) {}
+
+  bool resolve(const char *rna_path, const int array_index, PathResolvedRNA *r_result)
+  {
+    if (rna_path_ != nullptr && rna_path != nullptr &&
+        (rna_path_ == rna_path || STREQ(rna_path_, rna_path)))
+    {
+      return BKE_animsys_rna_path_resolve_array_index(&path_result_, array_index, r_result);
+    }
+
+    rna_path_ = nullptr;
+    if (!BKE_animsys_rna_path_resolve(ptr_, rna_path, array_index, r_result)) {
+      return false;
+    }
+    rna_path_ = rna_path;
+    path_result_ = *r_result;
+    return true;
+  }
+};
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -571,6 +617,14 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathResolver resolver(ptr);
+
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+  AnimsysPathResolver orig_resolver(&ptr_orig);
+
   /* Calculate then execute each curve. */
   for (FCurve *fcu : fcurves) {
 
@@ -579,11 +633,14 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (resolver.resolve(fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+      PathResolvedRNA orig_anim_rna;
+      if (flush_to_original &&
+          orig_resolver.resolve(fcu->rna_path, fcu->array_index, &orig_anim_rna))
+      {
+        BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
       }
     }
   }
@@ -652,6 +709,7 @@ static void animsys_blend_in_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      const float blend_factor)
 {
+  AnimsysPathResolver resolver(ptr);
   char *channel_to_skip = nullptr;
   int num_channels_to_skip = 0;
   for (int fcurve_index : fcurves.index_range()) {
@@ -673,7 +731,7 @@ static void animsys_blend_in_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (!resolver.resolve(fcu->rna_path, fcu->array_index, &anim_rna)) {
       continue;
     }
 
@@ -852,11 +910,12 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  AnimsysPathResolver resolver(ptr);
   const auto visit_fcurve = [&](FCurve *fcu) {
     /* check if this curve should be skipped */
     if ((fcu->flag & FCURVE_MUTED) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (resolver.resolve(fcu->rna_path, fcu->array_index, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
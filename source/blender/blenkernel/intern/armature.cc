@@ -2036,6 +2036,16 @@ void BKE_bone_offset_matrix_get(const Bone *bone, float offs_bone[4][4])
   offs_bone[3][1] += bone->parent->length;
 }
 
+void BKE_bone_arm_mat_invert(const Bone *bone, float r_arm_mat_inv[4][4])
+{
+  /* Inverse of `[R | t]` is `[transpose(R) | -transpose(R) * t]`. */
+  float rot_inv[3][3];
+  transpose_m3_m4(rot_inv, bone->arm_mat);
+  copy_m4_m3(r_arm_mat_inv, rot_inv);
+  mul_v3_m3v3(r_arm_mat_inv[3], rot_inv, bone->arm_mat[3]);
+  negate_v3(r_arm_mat_inv[3]);
+}
+
 void BKE_bone_parent_transform_calc_from_pchan(const bPoseChannel *pchan,
                                                BoneParentTransform *r_bpt)
 {
@@ -3009,7 +3019,7 @@ void BKE_pose_where_is(Depsgraph *depsgraph, Scene *scene, Object *ob)
   /* calculating deform matrices */
   LISTBASE_FOREACH (bPoseChannel *, pchan, &ob->pose->chanbase) {
     if (pchan->bone) {
-      invert_m4_m4(imat, pchan->bone->arm_mat);
+      BKE_bone_arm_mat_invert(pchan->bone, imat);
       mul_m4_m4m4(pchan->chan_mat, pchan->pose_mat, imat);
     }
   }
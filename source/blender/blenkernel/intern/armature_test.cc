@@ -353,6 +353,29 @@ TEST_VEC_ROLL_TO_MAT3_ORTHOGONAL(OrthoP_000_100, 1, 0, 0, 0.005, 0.100)
 TEST_VEC_ROLL_TO_MAT3_ORTHOGONAL(OrthoP_005_005, 1, 0, 0.005, 0, 0.005)
 TEST_VEC_ROLL_TO_MAT3_ORTHOGONAL(OrthoP_100_100, 1, 0.005, 0.100, 0.005, 0.100)
 
+TEST(BKE_bone_arm_mat_invert, MatchesGeneralInverse)
+{
+  Bone parent = {};
+  Bone child = {};
+  copy_v3_fl3(parent.head, 1.0f, -2.0f, 0.5f);
+  copy_v3_fl3(parent.tail, 1.5f, -1.0f, 2.0f);
+  parent.roll = 0.3f;
+  copy_v3_fl3(child.head, 0.2f, 0.0f, -0.4f);
+  copy_v3_fl3(child.tail, -1.0f, 0.7f, 0.1f);
+  child.roll = -1.2f;
+  child.parent = &parent;
+  BLI_addtail(&parent.childbase, &child);
+
+  BKE_armature_where_is_bone(&parent, nullptr, true);
+
+  for (const Bone *bone : {&parent, &child}) {
+    float expected[4][4], actual[4][4];
+    invert_m4_m4(expected, bone->arm_mat);
+    BKE_bone_arm_mat_invert(bone, actual);
+    EXPECT_M4_NEAR(actual, expected, 1e-5f);
+  }
+}
+
 class BKE_armature_find_selected_bones_test : public testing::Test {
  protected:
   bArmature arm;
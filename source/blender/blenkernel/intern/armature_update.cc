@@ -957,7 +957,7 @@ void BKE_pose_bone_done(Depsgraph *depsgraph, Object *object, int pchan_index)
   DEG_debug_print_eval_subdata(
       depsgraph, __func__, object->id.name, object, "pchan", pchan->name, pchan);
   if (pchan->bone) {
-    invert_m4_m4(imat, pchan->bone->arm_mat);
+    BKE_bone_arm_mat_invert(pchan->bone, imat);
     mul_m4_m4m4(pchan->chan_mat, pchan->pose_mat, imat);
     if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
       mat4_to_dquat(&pchan->runtime.deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
@@ -100,7 +100,9 @@ bool BKE_memfile_undo_decode(MemFileUndoData *mfu,
   return success;
 }
 
-MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
+MemFileUndoData *BKE_memfile_undo_encode(Main *bmain,
+                                         MemFileUndoData *mfu_prev,
+                                         const bool use_deferred_write)
 {
   MemFileUndoData *mfu = MEM_cnew<MemFileUndoData>(__func__);
 
@@ -133,7 +135,8 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
     if (prevfile) {
       BLO_memfile_clear_future(prevfile);
     }
-    /* success = */ /* UNUSED */ BLO_write_file_mem(bmain, prevfile, &mfu->memfile, fileflags);
+    /* success = */ /* UNUSED */ BLO_write_file_mem(
+        bmain, prevfile, &mfu->memfile, fileflags, use_deferred_write);
     mfu->undo_size = mfu->memfile.size;
   }
 
@@ -142,6 +145,17 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
   return mfu;
 }
 
+void BKE_memfile_undo_encode_deferred(MemFileUndoData *mfu)
+{
+  BLO_memfile_write_deferred(&mfu->memfile);
+  mfu->undo_size = mfu->memfile.size;
+}
+
+void BKE_memfile_undo_encode_deferred_end(MemFileUndoData *mfu)
+{
+  BLO_memfile_write_deferred_end(&mfu->memfile);
+}
+
 void BKE_memfile_undo_free(MemFileUndoData *mfu)
 {
   BLO_memfile_free(&mfu->memfile);
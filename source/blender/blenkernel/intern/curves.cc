@@ -147,7 +147,8 @@ IDTypeInfo IDType_ID_CV = {
     /*name*/ "Curves",
     /*name_plural*/ N_("hair_curves"),
     /*translation_context*/ BLT_I18NCONTEXT_ID_CURVES,
-    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE,
+    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE | IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE |
+        IDTYPE_FLAGS_UNDO_CHANGES_ARE_TAGGED,
     /*asset_type_info*/ nullptr,
 
     /*init_data*/ curves_init_data,
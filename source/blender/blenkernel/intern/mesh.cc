@@ -397,7 +397,7 @@ IDTypeInfo IDType_ID_ME = {
     /*name*/ "Mesh",
     /*name_plural*/ N_("meshes"),
     /*translation_context*/ BLT_I18NCONTEXT_ID_MESH,
-    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE,
+    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE | IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE,
     /*asset_type_info*/ nullptr,
 
     /*init_data*/ mesh_init_data,
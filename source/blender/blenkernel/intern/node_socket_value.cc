@@ -271,6 +271,11 @@ bool SocketValueVariant::is_context_dependent_field() const
   return field.node().depends_on_input();
 }
 
+bool SocketValueVariant::is_single() const
+{
+  return kind_ == Kind::Single;
+}
+
 bool SocketValueVariant::is_volume_grid() const
 {
   return kind_ == Kind::Grid;
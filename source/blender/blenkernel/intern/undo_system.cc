@@ -16,6 +16,7 @@
 #include "BLI_listbase.h"
 #include "BLI_string.h"
 #include "BLI_sys_types.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -158,6 +159,79 @@ static void undosys_id_ref_resolve(void *user_data, UndoRefID *id_ref)
       (id_ref->library_filepath_abs[0] ? id_ref->library_filepath_abs : nullptr));
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous Encoding
+ *
+ * Undo types may leave part of the encoding to a worker thread so it doesn't block the UI after
+ * each operator, see #UndoType.step_encode_async. Only one step is encoded at a time.
+ * \{ */
+
+struct UndoStackEncodeAsync {
+  TaskPool *task_pool;
+  UndoStep *us;
+  /** Result of #UndoType.step_encode_async, applied to the step when done. */
+  size_t data_size;
+};
+
+static void undosys_step_encode_async_fn(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  UndoStackEncodeAsync *encode_async = static_cast<UndoStackEncodeAsync *>(
+      BLI_task_pool_user_data(pool));
+  UndoStep *us = encode_async->us;
+  encode_async->data_size = us->type->step_encode_async(us);
+}
+
+static void undosys_step_encode_async_begin(UndoStack *ustack, UndoStep *us)
+{
+  BLI_assert(ustack->encode_async == nullptr);
+  BLI_assert(us->type->step_encode_async != nullptr);
+  CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
+
+  UndoStackEncodeAsync *encode_async = MEM_new<UndoStackEncodeAsync>(__func__);
+  encode_async->us = us;
+  encode_async->data_size = us->data_size;
+  encode_async->task_pool = BLI_task_pool_create_background(encode_async, TASK_PRIORITY_HIGH);
+  BLI_task_pool_push(
+      encode_async->task_pool, undosys_step_encode_async_fn, nullptr, false, nullptr);
+  ustack->encode_async = encode_async;
+}
+
+void BKE_undosys_stack_encode_async_wait(UndoStack *ustack)
+{
+  UndoStackEncodeAsync *encode_async = ustack->encode_async;
+  if (encode_async == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(encode_async->task_pool);
+  BLI_task_pool_free(encode_async->task_pool);
+
+  UndoStep *us = encode_async->us;
+  us->data_size = encode_async->data_size;
+  us->use_encode_async = false;
+  if (us->type->step_encode_async_end) {
+    us->type->step_encode_async_end(us);
+  }
+  CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
+
+  MEM_delete(encode_async);
+  ustack->encode_async = nullptr;
+}
+
+/**
+ * Whether freeing \a us requires waiting for the step encoded in the background: the step
+ * itself, or the previous one of the same type that it is encoded relative to.
+ */
+static bool undosys_step_encode_async_uses(const UndoStack *ustack, UndoStep *us)
+{
+  if (ustack->encode_async == nullptr) {
+    return false;
+  }
+  UndoStep *us_async = ustack->encode_async->us;
+  return ELEM(us, us_async, BKE_undosys_step_same_type_prev(us_async));
+}
+
+/** \} */
+
 static bool undosys_step_encode(bContext *C, Main *bmain, UndoStack *ustack, UndoStep *us)
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
@@ -180,6 +254,9 @@ static bool undosys_step_encode(bContext *C, Main *bmain, UndoStack *ustack, Und
   if (ok == false) {
     CLOG_INFO(&LOG, 2, "encode callback didn't create undo step");
   }
+  else if (us->use_encode_async) {
+    undosys_step_encode_async_begin(ustack, us);
+  }
   return ok;
 }
 
@@ -192,6 +269,9 @@ static void undosys_step_decode(bContext *C,
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
 
+  /* The step (or the one it is decoded on top of) may still be encoded in the background. */
+  BKE_undosys_stack_encode_async_wait(ustack);
+
   if (us->type->step_foreach_ID_ref) {
 #ifdef WITH_GLOBAL_UNDO_CORRECT_ORDER
     if (us->type != BKE_UNDOSYS_TYPE_MEMFILE) {
@@ -231,6 +311,9 @@ static void undosys_step_decode(bContext *C,
 static void undosys_step_free_and_unlink(UndoStack *ustack, UndoStep *us)
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
+  if (undosys_step_encode_async_uses(ustack, us)) {
+    BKE_undosys_stack_encode_async_wait(ustack);
+  }
   UNDO_NESTED_CHECK_BEGIN;
   us->type->step_free(us);
   UNDO_NESTED_CHECK_END;
@@ -404,6 +487,28 @@ UndoStep *BKE_undosys_stack_init_or_active_with_type(UndoStack *ustack, const Un
   return BKE_undosys_stack_active_with_type(ustack, ut);
 }
 
+/**
+ * Let undo types reduce the memory used by their steps when \a memory_limit is exceeded.
+ */
+static void undosys_stack_compress_to_limit(UndoStack *ustack, const size_t memory_limit)
+{
+  size_t data_size_all = 0;
+  LISTBASE_FOREACH (const UndoStep *, us, &ustack->steps) {
+    data_size_all += us->data_size;
+  }
+  if (data_size_all <= memory_limit) {
+    return;
+  }
+  CLOG_INFO(&LOG, 1, "data_size_all=%zu > memory_limit=%zu", data_size_all, memory_limit);
+  LISTBASE_FOREACH (const UndoType *, ut, &g_undo_types) {
+    if (ut->stack_compress != nullptr) {
+      UNDO_NESTED_CHECK_BEGIN;
+      ut->stack_compress(ustack);
+      UNDO_NESTED_CHECK_END;
+    }
+  }
+}
+
 void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size_t memory_limit)
 {
   UNDO_NESTED_ASSERT(false);
@@ -412,6 +517,10 @@ void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size
   }
 
   CLOG_INFO(&LOG, 1, "steps=%d, memory_limit=%zu", steps, memory_limit);
+  if (memory_limit) {
+    undosys_stack_compress_to_limit(ustack, memory_limit);
+  }
+
   UndoStep *us;
   UndoStep *us_exclude = nullptr;
   /* keep at least two (original + other) */
@@ -526,6 +635,9 @@ eUndoPushReturn BKE_undosys_step_push_with_type(UndoStack *ustack,
   UNDO_NESTED_ASSERT(false);
   undosys_stack_validate(ustack, false);
   bool is_not_empty = ustack->step_active != nullptr;
+
+  /* The new step may be encoded relative to the previous one. */
+  BKE_undosys_stack_encode_async_wait(ustack);
   eUndoPushReturn retval = UNDO_PUSH_RET_FAILURE;
 
   /* Might not be final place for this to be called - probably only want to call it from some
@@ -27,6 +27,7 @@ typedef int64_t off64_t;
 extern "C" {
 #endif
 
+struct BLI_mmap_file;
 struct FileReader;
 
 typedef int64_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
@@ -54,6 +55,12 @@ typedef struct FileReader {
 FileReader *BLI_filereader_new_file(int filedes) ATTR_WARN_UNUSED_RESULT;
 /** Create #FileReader from raw file descriptor using memory-mapped IO. */
 FileReader *BLI_filereader_new_mmap(int filedes) ATTR_WARN_UNUSED_RESULT;
+/**
+ * Create #FileReader from an existing memory-mapped file.
+ * The reader doesn't take ownership, the mapping has to outlive it and be freed by the caller.
+ */
+FileReader *BLI_filereader_new_mmap_file(struct BLI_mmap_file *mmap) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL();
 /** Create #FileReader from a region of memory. */
 FileReader *BLI_filereader_new_memory(const void *data, size_t len) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL();
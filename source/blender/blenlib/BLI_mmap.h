@@ -25,6 +25,9 @@ typedef struct BLI_mmap_file BLI_mmap_file;
  * May return NULL if the operation fails.
  * Note that this seeks to the end of the file to determine its length. */
 BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+/* Same as #BLI_mmap_open, but when `copy_on_write` is set the mapped memory can also be written
+ * to. Written pages become private copies, the file itself is never modified. */
+BLI_mmap_file *BLI_mmap_open_ex(int fd, bool copy_on_write) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 
 /* Reads length bytes from file at the given offset into dest.
  * Returns whether the operation was successful (may fail when reading beyond the file
@@ -14,14 +14,16 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, e, tau, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
+ *      abs, fabs, floor, ceil, trunc, round, int, float, bool,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log, log1p, log2, log10, sqrt, pow, fmod, hypot, copysign,
+ *      clamp, lerp, smoothstep
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -302,6 +304,52 @@ static double op_sub(double a, double b)
   return a - b;
 }
 
+/* Python `%` operator: unlike `fmod`, the result has the sign of the divisor. */
+static double op_mod(double a, double b)
+{
+  double result = fmod(a, b);
+  if (result != 0.0 && ((result < 0.0) != (b < 0.0))) {
+    result += b;
+  }
+  return result;
+}
+
+/**
+ * Python `//` operator, ported from `float_floor_div` in CPython. Computing `floor(a / b)` would
+ * be wrong when `a / b` rounds up to an integer, e.g. `1 // 0.1` has to be 9 and not 10, so that
+ * `a == b * (a // b) + a % b` holds.
+ */
+static double op_floordiv(double a, double b)
+{
+  if (b == 0.0) {
+    /* Raise the division by zero exception. */
+    return a / b;
+  }
+  const double mod = fmod(a, b);
+  double div = (a - mod) / b;
+  if (mod != 0.0 && ((b < 0.0) != (mod < 0.0))) {
+    div -= 1.0;
+  }
+  if (div == 0.0) {
+    return copysign(0.0, a / b);
+  }
+  double floordiv = floor(div);
+  if (div - floordiv > 0.5) {
+    floordiv += 1.0;
+  }
+  return floordiv;
+}
+
+static double op_bool(double arg)
+{
+  return arg ? 1.0 : 0.0;
+}
+
+static double op_float(double arg)
+{
+  return arg;
+}
+
 static double op_radians(double arg)
 {
   return arg * M_PI / 180.0;
@@ -382,7 +430,7 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI}, {"e", M_E}, {"tau", 2.0 * M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -407,6 +455,8 @@ static BuiltinOpDef builtin_ops[] = {
     {"trunc", OPCODE_FUNC1, trunc},
     {"round", OPCODE_FUNC1, round},
     {"int", OPCODE_FUNC1, trunc},
+    {"float", OPCODE_FUNC1, op_float},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"sin", OPCODE_FUNC1, sin},
     {"cos", OPCODE_FUNC1, cos},
     {"tan", OPCODE_FUNC1, tan},
@@ -414,12 +464,24 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log1p", OPCODE_FUNC1, log1p},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -449,6 +511,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_LE MAKE_CHAR2('<', '=')
 #define TOKEN_NE MAKE_CHAR2('!', '=')
 #define TOKEN_EQ MAKE_CHAR2('=', '=')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 #define TOKEN_AND MAKE_CHAR2('A', 'N')
 #define TOKEN_OR MAKE_CHAR2('O', 'R')
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
@@ -692,6 +756,13 @@ static bool parse_next_token(ExprParseState *state)
     return (end == out);
   }
 
+  /* ** and // tokens */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* ?= tokens */
   if (state->cur[1] == '=' && strchr(token_eq_characters, state->cur[0])) {
     state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
@@ -771,19 +842,13 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_unary(ExprParseState *state);
+
+static bool parse_primary(ExprParseState *state)
 {
   int i;
 
   switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
-
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
-
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -855,6 +920,36 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+/* Like in Python, the power operator binds tighter than a unary operator on its left but not on
+ * its right, and is right-associative: `-2 ** -2 ** 2` is `-(2 ** (-(2 ** 2)))`. */
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -871,6 +966,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
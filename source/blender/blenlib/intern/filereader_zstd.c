@@ -18,6 +18,23 @@
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Number of decompressed frames kept in memory when reading a seekable file.
+ *
+ * Reading .blend files on demand interleaves sequential #BHead scanning with reads of data
+ * blocks located in earlier frames, with a single cached frame every such read would also
+ * force the frame being scanned to be decompressed again.
+ */
+#define ZSTD_SEEK_CACHE_SIZE 4
+
+typedef struct ZstdFrameCache {
+  char *content;
+  /** Index of the cached frame, -1 when this entry is unused. */
+  int frame;
+  /** Value of #ZstdReader.seek.use_counter on last access, for LRU eviction. */
+  uint64_t last_use;
+} ZstdFrameCache;
+
 typedef struct {
   FileReader reader;
 
@@ -32,8 +49,12 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    ZstdFrameCache cache[ZSTD_SEEK_CACHE_SIZE];
+    uint64_t use_counter;
+
+    /** Re-used buffer for the compressed data of a frame. */
+    char *compressed_buf;
+    size_t compressed_buf_size;
   } seek;
 } ZstdReader;
 
@@ -129,7 +150,9 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
+  for (int i = 0; i < ZSTD_SEEK_CACHE_SIZE; i++) {
+    zstd->seek.cache[i].frame = -1;
+  }
 
   return true;
 }
@@ -157,41 +180,80 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+static size_t zstd_frame_uncompressed_size(const ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
-  }
-
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  return zstd->seek.uncompressed_ofs[frame + 1] - zstd->seek.uncompressed_ofs[frame];
+}
 
+/* Read and decompress the given frame into `r_data`,
+ * which must be large enough to hold the whole uncompressed frame. */
+static bool zstd_decompress_frame(ZstdReader *zstd, int frame, char *r_data)
+{
   size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  size_t uncompressed_size = zstd_frame_uncompressed_size(zstd, frame);
+
+  if (zstd->seek.compressed_buf_size < compressed_size) {
+    MEM_SAFE_FREE(zstd->seek.compressed_buf);
+    zstd->seek.compressed_buf = MEM_mallocN(compressed_size, __func__);
+    zstd->seek.compressed_buf_size = compressed_size;
+  }
+  char *compressed_data = zstd->seek.compressed_buf;
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
-  char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
   {
-    MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
-    return NULL;
+    return false;
   }
 
   size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
-  MEM_freeN(compressed_data);
+      zstd->ctx, r_data, uncompressed_size, compressed_data, compressed_size);
   if (ZSTD_isError(res) || res < uncompressed_size) {
+    return false;
+  }
+  return true;
+}
+
+/* Find the cached content of the given frame, NULL if it's not cached. */
+static const char *zstd_cache_lookup(ZstdReader *zstd, int frame)
+{
+  for (int i = 0; i < ZSTD_SEEK_CACHE_SIZE; i++) {
+    ZstdFrameCache *entry = &zstd->seek.cache[i];
+    if (entry->frame == frame) {
+      entry->last_use = ++zstd->seek.use_counter;
+      return entry->content;
+    }
+  }
+  return NULL;
+}
+
+/* Ensure that the given frame is cached, evicting the least recently used one if needed. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  const char *cached_content = zstd_cache_lookup(zstd, frame);
+  if (cached_content) {
+    return cached_content;
+  }
+
+  /* Unused entries have a zero `last_use`, so they are picked first. */
+  ZstdFrameCache *entry = &zstd->seek.cache[0];
+  for (int i = 1; i < ZSTD_SEEK_CACHE_SIZE; i++) {
+    if (zstd->seek.cache[i].last_use < entry->last_use) {
+      entry = &zstd->seek.cache[i];
+    }
+  }
+  MEM_SAFE_FREE(entry->content);
+  entry->frame = -1;
+  entry->last_use = 0;
+
+  char *uncompressed_data = MEM_mallocN(zstd_frame_uncompressed_size(zstd, frame), __func__);
+  if (!zstd_decompress_frame(zstd, frame, uncompressed_data)) {
     MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
+  entry->frame = frame;
+  entry->content = uncompressed_data;
+  entry->last_use = ++zstd->seek.use_counter;
   return uncompressed_data;
 }
 
@@ -207,17 +269,28 @@ static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
       break;
     }
 
-    const char *framedata = zstd_ensure_cache(zstd, frame);
-    if (framedata == NULL) {
-      /* Error while reading the frame, so return as much as we can. */
-      break;
-    }
-
     size_t frame_end_offset = min_zz(zstd->seek.uncompressed_ofs[frame + 1], end_offset);
     size_t frame_read_len = frame_end_offset - zstd->reader.offset;
-
     size_t offset_in_frame = zstd->reader.offset - zstd->seek.uncompressed_ofs[frame];
-    memcpy((char *)buffer + read_len, framedata + offset_in_frame, frame_read_len);
+
+    if (offset_in_frame == 0 && frame_read_len == zstd_frame_uncompressed_size(zstd, frame) &&
+        zstd_cache_lookup(zstd, frame) == NULL)
+    {
+      /* The whole frame is requested (typically a large data block),
+       * decompress it directly into the output instead of going through the cache. */
+      if (!zstd_decompress_frame(zstd, frame, (char *)buffer + read_len)) {
+        break;
+      }
+    }
+    else {
+      const char *framedata = zstd_ensure_cache(zstd, frame);
+      if (framedata == NULL) {
+        /* Error while reading the frame, so return as much as we can. */
+        break;
+      }
+      memcpy((char *)buffer + read_len, framedata + offset_in_frame, frame_read_len);
+    }
+
     read_len += frame_read_len;
     zstd->reader.offset = frame_end_offset;
   }
@@ -285,10 +358,11 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
+    /* When an error has occurred these may be NULL, see: #99744. */
+    for (int i = 0; i < ZSTD_SEEK_CACHE_SIZE; i++) {
+      MEM_SAFE_FREE(zstd->seek.cache[i].content);
     }
+    MEM_SAFE_FREE(zstd->seek.compressed_buf);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -114,6 +114,7 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "1 **")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -146,6 +147,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(E, "e", M_E)
+TEST_CONST(Tau, "tau", 2.0 * M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -159,6 +162,16 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(1000)", 3.0)
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -0.5)", -2.0)
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+TEST_EVAL(Cosh, "cosh(x)", 0.0, 1.0)
+
+TEST_CONST(Float, "float(1.5)", 1.5)
+TEST_CONST(Bool1, "bool(-2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -215,6 +228,30 @@ TEST_CONST(Arith4, "3 * (-2 + 1)", -3.0)
 
 TEST_EVAL(Arith1, "1 + -x * 3", 2, -5.0)
 
+TEST_CONST(Power1, "2 ** 3", 8.0)
+TEST_CONST(Power2, "-2 ** 2", -4.0)
+TEST_CONST(Power3, "2 ** -1", 0.5)
+TEST_CONST(Power4, "2 ** 3 ** 2", 512.0)
+TEST_CONST(Power5, "2 * 3 ** 2", 18.0)
+TEST_CONST(Power6, "(-2) ** 2", 4.0)
+TEST_EVAL(Power1, "x ** 2", 3, 9.0)
+TEST_EVAL(Power2, "2 ** -x ** 2", 1, 0.5)
+
+TEST_CONST(Mod1, "7 % 3", 1.0)
+TEST_CONST(Mod2, "-7 % 3", 2.0)
+TEST_CONST(Mod3, "7 % -3", -2.0)
+TEST_CONST(Mod4, "5.5 % 2", 1.5)
+TEST_EVAL(Mod1, "x % 1", -0.25, 0.75)
+
+TEST_CONST(FloorDiv1, "7 // 2", 3.0)
+TEST_CONST(FloorDiv2, "-7 // 2", -4.0)
+TEST_CONST(FloorDiv3, "1 + 7 // 2 * 3", 10.0)
+TEST_CONST(FloorDivFrac, "1 // 0.1", 9.0)
+TEST_CONST(FloorDivNeg1, "-1 // 0.1", -10.0)
+TEST_CONST(FloorDivNeg2, "7 // -2", -4.0)
+TEST_CONST(FloorDivNeg3, "-7.5 // -2", 3.0)
+TEST_EVAL(FloorDiv1, "x // 0.5", 1.75, 3.0)
+
 TEST_CONST(Eq1, "1 == 1.0", TRUE_VAL)
 TEST_CONST(Eq2, "1 == 2.0", FALSE_VAL)
 TEST_CONST(Eq3, "True == 1", TRUE_VAL)
@@ -340,6 +377,10 @@ TEST_ERROR(SqrtDomain3, "sqrt(x)", 0.0, EXPR_PYLIKE_SUCCESS)
 TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
+TEST_ERROR(PowDomain4, "(-1) ** x", 0.5, EXPR_PYLIKE_MATH_ERROR)
+
+TEST_ERROR(ModZero1, "1 % x", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(FloorDivZero1, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
@@ -52,6 +52,11 @@ enum {
    * (written to #BLENDER_STARTUP_FILE & #BLENDER_USERPREF_FILE).
    */
   BLO_CODE_USER = BLEND_MAKE_ID('U', 'S', 'E', 'R'),
+  /**
+   * Reference to the content of a #BLO_CODE_DATA block stored in an external chunk store
+   * (see `chunk_store.hh`), replaced by the actual #BLO_CODE_DATA block when reading.
+   */
+  BLO_CODE_DREF = BLEND_MAKE_ID('D', 'R', 'E', 'F'),
   /**
    * Terminate reading (no data).
    */
@@ -14,6 +14,7 @@
 struct AssetMetaData;
 struct BHead;
 struct BlendfileLinkAppendContext;
+struct BlendFileIndex;
 struct BlendHandle;
 struct BlendThumbnail;
 struct FileData;
@@ -96,6 +97,42 @@ struct BlendFileReadParams {
   int undo_direction; /* #eUndoStepDir */
 };
 
+/** Statistics of a single stage of reading a blend-file, see #BlendFileReadPhases. */
+struct BlendFileReadPhaseStats {
+  double duration;
+  /** Amount of data read from the file(s), in bytes. */
+  uint64_t bytes_read;
+  /**
+   * Difference in allocated memory (in bytes) and in number of allocated blocks over the stage.
+   * Only gathered for the stages that are not interleaved with others.
+   */
+  int64_t memory;
+  int64_t memory_blocks;
+};
+
+/**
+ * Statistics of the stages of reading a blend-file, accumulated over the file and its libraries.
+ *
+ * Only gathered with `--debug-io` (#G_DEBUG_IO). #bhead_scan and #read_struct are interleaved
+ * with the other stages, and are also accounted for in the stage they happen in.
+ */
+struct BlendFileReadPhases {
+  /** Reading the file header and its DNA. */
+  BlendFileReadPhaseStats header_dna;
+  /** Reading block headers (and their data, unless read on demand) from the file. */
+  BlendFileReadPhaseStats bhead_scan;
+  /** Reading the data-blocks of the main file. */
+  BlendFileReadPhaseStats read_data;
+  /** Converting blocks from the file DNA to the current one (#read_struct). */
+  BlendFileReadPhaseStats read_struct;
+  /** Versioning, including the versioning done after linking. */
+  BlendFileReadPhaseStats versioning;
+  /** Restoring ID pointers (#lib_link_all). */
+  BlendFileReadPhaseStats lib_link;
+  /** Processing of the IDs once all of them are linked (#after_liblink_merged_bmain_process). */
+  BlendFileReadPhaseStats after_liblink;
+};
+
 struct BlendFileReadReport {
   /** General reports handling. */
   ReportList *reports;
@@ -109,6 +146,9 @@ struct BlendFileReadReport {
     double lib_overrides_recursive_resync;
   } duration;
 
+  /** Detailed timing information, see #BlendFileReadPhases. */
+  BlendFileReadPhases phases;
+
   /** Count information. */
   struct {
     /**
@@ -325,6 +365,25 @@ LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh);
  */
 void BLO_blendhandle_close(BlendHandle *bh) ATTR_NONNULL(1);
 
+/**
+ * Get the persistent index of the linkable data-blocks of a blend-file, stored in the cache
+ * directory. It allows listing them without reading the file, as long as its size and
+ * modification time didn't change. Otherwise the file is read and the index is written again.
+ *
+ * \param filepath: The file path of the blend-file.
+ * \param reports: Report errors in opening the file (can be NULL).
+ * \return The index, or NULL when the file couldn't be read. Free with #BLO_blendfile_index_free.
+ */
+BlendFileIndex *BLO_blendfile_index_ensure(const char *filepath, BlendFileReadReport *reports);
+/**
+ * Same as #BLO_blendhandle_get_datablock_names, using the index of a blend-file.
+ */
+LinkNode *BLO_blendfile_index_get_datablock_names(const BlendFileIndex *index,
+                                                  int ofblocktype,
+                                                  bool use_assets_only,
+                                                  int *r_tot_names);
+void BLO_blendfile_index_free(BlendFileIndex *index) ATTR_NONNULL(1);
+
 /**
  * Mark the given Main (and the 'root' local one in case of lib-split Mains) as invalid, and
  * generate an error report containing given `message`.
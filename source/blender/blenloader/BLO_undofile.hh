@@ -12,11 +12,14 @@
 #include "BLI_filereader.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 namespace blender {
 class ImplicitSharingInfo;
 }
 struct Main;
+struct MemFileDeferredWrite;
 struct Scene;
 
 struct MemFileSharedStorage {
@@ -24,6 +27,12 @@ struct MemFileSharedStorage {
    * Maps the data pointer to the sharing info that it is owned by.
    */
   blender::Map<const void *, const blender::ImplicitSharingInfo *> map;
+  /**
+   * The data added to #map while writing each ID (by session UID), with its approximate size.
+   * Used to add it again when the ID is not written in the next step, see
+   * #BLO_memfile_write_id_reuse.
+   */
+  blender::Map<uint, blender::Vector<std::pair<const void *, size_t>>> data_by_id_session_uid;
 
   ~MemFileSharedStorage();
 };
@@ -42,6 +51,11 @@ struct MemFileChunk {
   /** Session UID of the ID being currently written (MAIN_ID_SESSION_UID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uid;
+  /** When true, #buf is compressed (see #BLO_memfile_compress), it has to be decompressed
+   * before the memfile can be read or compared with. Shared by all chunks using the same #buf. */
+  bool is_compressed;
+  /** Size of #buf in bytes when #is_compressed. */
+  size_t compressed_size;
 };
 
 struct MemFile {
@@ -52,6 +66,11 @@ struct MemFile {
    * without making a copy. This is faster and requires less memory.
    */
   MemFileSharedStorage *shared_storage;
+  /**
+   * IDs which still have to be written into this memfile, see #BLO_memfile_write_deferred.
+   * Only set until #BLO_memfile_write_deferred_end, after the undo step was written.
+   */
+  MemFileDeferredWrite *deferred_write;
 };
 
 struct MemFileWriteData {
@@ -89,6 +108,13 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add the chunks (and shared data) stored for the given ID in the reference memfile again,
+ * instead of writing the ID. Only valid when the ID is known to be unchanged.
+ *
+ * \return false when the ID isn't in the reference memfile, it has to be written then.
+ */
+bool BLO_memfile_write_id_reuse(MemFileWriteData *mem_data, uint id_session_uid);
 
 /* exports */
 
@@ -107,6 +133,21 @@ void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Compress the chunk buffers owned by \a memfiles, except the ones also used by
+ * \a memfiles_keep. Since identical chunks share buffers with previous memfiles, \a memfiles and
+ * \a memfiles_keep must contain all memfiles of the undo stack together.
+ */
+void BLO_memfile_compress(blender::Span<MemFile *> memfiles,
+                          blender::Span<const MemFile *> memfiles_keep);
+/**
+ * Decompress all chunks used by \a memfile, so it can be read or compared with.
+ * \a memfiles must contain all memfiles of the undo stack.
+ *
+ * \return False when the compressed data is corrupt. No chunk is decompressed then, so
+ * \a memfile must not be read.
+ */
+bool BLO_memfile_decompress(blender::Span<MemFile *> memfiles, MemFile *memfile);
 
 /* Utilities. */
 
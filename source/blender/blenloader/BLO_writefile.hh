@@ -43,6 +43,12 @@ struct BlendFileWriteParams {
   uint use_save_as_copy : 1;
   uint use_userdef : 1;
   const BlendThumbnail *thumb;
+  /**
+   * When set, store large data arrays in this directory as content-addressed chunks, which can be
+   * shared by successive saves of the file and by other files using the same directory. The
+   * blend-file then only references these chunks, and can't be read without the directory.
+   */
+  const char *chunk_store_dirpath;
 };
 
 /**
@@ -55,8 +61,23 @@ extern bool BLO_write_file(Main *mainvar,
                            ReportList *reports);
 
 /**
+ * \param use_deferred_write: Allow leaving some IDs to be written later by
+ * #BLO_memfile_write_deferred, #MemFile.deferred_write is set when this is the case.
  * \return Success.
  */
-extern bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags);
+extern bool BLO_write_file_mem(
+    Main *mainvar, MemFile *compare, MemFile *current, int write_flags, bool use_deferred_write);
+/**
+ * Write the IDs left for later by #BLO_write_file_mem into \a memfile.
+ *
+ * This can be called from a worker thread. Neither \a memfile nor the memfile it was compared to
+ * when written may be used meanwhile, but the Main database is not accessed.
+ */
+extern void BLO_memfile_write_deferred(MemFile *memfile);
+/**
+ * Free what was kept for #BLO_memfile_write_deferred, which must have been called before.
+ * Has to be called from the main thread, since it frees ID copies.
+ */
+extern void BLO_memfile_write_deferred_end(MemFile *memfile);
 
 /** \} */
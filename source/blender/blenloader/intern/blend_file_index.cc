@@ -0,0 +1,301 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ *
+ * Persistent index of the data-blocks of blend-files, stored in the cache directory.
+ *
+ * Listing the data-blocks of a blend-file normally requires reading all of its blocks, since the
+ * file has no table of contents and its DNA is stored at the end. For libraries that are linked
+ * from over and over, the index stores the type, the name and the asset status of each linkable
+ * data-block. The size and modification time of the file it was created from are stored with
+ * them, and the index is only used while they still match.
+ *
+ * Index files are stored as `<caches>/blend-file-indices/<hash of the file path>.index`.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+
+#include <xxhash.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_linklist.h"
+#include "BLI_path_utils.hh"
+#include "BLI_string.h"
+#include "BLI_system.h"
+#include "BLI_vector.hh"
+#include BLI_SYSTEM_PID_H
+
+#include "BKE_appdir.hh"
+#include "BKE_idtype.hh"
+
+#include "BLO_blend_defs.hh"
+#include "BLO_readfile.hh"
+
+#include "readfile.hh"
+
+#include "CLG_log.h"
+
+static CLG_LogRef LOG = {"blo.blend_file_index"};
+
+/** Bump when the format of index files changes, older index files are then recreated. */
+#define BLEND_FILE_INDEX_VERSION 1
+
+static const char blend_file_index_magic[8] = {'B', 'L', 'E', 'N', 'D', 'I', 'D', 'X'};
+
+struct BlendFileIndex {
+  struct Entry {
+    short idcode;
+    bool is_asset;
+    /** Name of the data-block, without the ID code prefix. */
+    std::string name;
+  };
+  blender::Vector<Entry> entries;
+};
+
+/** Header of index files, followed by the indexed file path and the entries. */
+struct BlendFileIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entries_num;
+  int64_t file_size;
+  int64_t file_mtime;
+  uint32_t filepath_len;
+  uint32_t _pad;
+};
+
+/** Stored for each entry in index files, followed by the name. */
+struct BlendFileIndexEntryHeader {
+  int16_t idcode;
+  uint16_t is_asset;
+  uint32_t name_len;
+};
+
+static bool blend_file_index_filepath(const char *filepath, char r_index_filepath[FILE_MAX])
+{
+  char caches_dirpath[FILE_MAX];
+  if (!BKE_appdir_folder_caches(caches_dirpath, sizeof(caches_dirpath))) {
+    return false;
+  }
+  char name[32];
+  SNPRINTF(name, "%016llx.index", (unsigned long long)XXH3_64bits(filepath, strlen(filepath)));
+  BLI_path_join(r_index_filepath, FILE_MAX, caches_dirpath, "blend-file-indices", name);
+  return true;
+}
+
+static bool blend_file_stat(const char *filepath, int64_t *r_size, int64_t *r_mtime)
+{
+  BLI_stat_t stat = {};
+  if (BLI_stat(filepath, &stat) == -1) {
+    return false;
+  }
+  *r_size = int64_t(stat.st_size);
+  *r_mtime = int64_t(stat.st_mtime);
+  return true;
+}
+
+/**
+ * Read the index of \a filepath, when it exists and was created from the file as it is now.
+ */
+static BlendFileIndex *blend_file_index_read(const char *filepath,
+                                             const char *index_filepath,
+                                             const int64_t file_size,
+                                             const int64_t file_mtime)
+{
+  size_t data_len = 0;
+  char *data = static_cast<char *>(BLI_file_read_binary_as_mem(index_filepath, 0, &data_len));
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  BlendFileIndexHeader header;
+  const size_t filepath_len = strlen(filepath);
+  if (data_len >= sizeof(header)) {
+    memcpy(&header, data, sizeof(header));
+  }
+  if (data_len < sizeof(header) + filepath_len ||
+      memcmp(header.magic, blend_file_index_magic, sizeof(header.magic)) != 0 ||
+      header.version != BLEND_FILE_INDEX_VERSION || header.file_size != file_size ||
+      header.file_mtime != file_mtime || header.filepath_len != filepath_len ||
+      memcmp(data + sizeof(header), filepath, filepath_len) != 0)
+  {
+    MEM_freeN(data);
+    return nullptr;
+  }
+
+  BlendFileIndex *index = MEM_new<BlendFileIndex>(__func__);
+  index->entries.reserve(header.entries_num);
+  size_t offset = sizeof(header) + filepath_len;
+  for (uint32_t i = 0; i < header.entries_num; i++) {
+    BlendFileIndexEntryHeader entry_header;
+    if (data_len < offset + sizeof(entry_header)) {
+      break;
+    }
+    memcpy(&entry_header, data + offset, sizeof(entry_header));
+    offset += sizeof(entry_header);
+    if (data_len < offset + entry_header.name_len) {
+      break;
+    }
+    BlendFileIndex::Entry entry;
+    entry.idcode = entry_header.idcode;
+    entry.is_asset = entry_header.is_asset != 0;
+    entry.name = std::string(data + offset, entry_header.name_len);
+    offset += entry_header.name_len;
+    index->entries.append(std::move(entry));
+  }
+  MEM_freeN(data);
+
+  if (index->entries.size() != header.entries_num) {
+    CLOG_WARN(&LOG, "Ignoring truncated index file '%s'", index_filepath);
+    MEM_delete(index);
+    return nullptr;
+  }
+  return index;
+}
+
+static void blend_file_index_write(const BlendFileIndex &index,
+                                   const char *filepath,
+                                   const char *index_filepath,
+                                   const int64_t file_size,
+                                   const int64_t file_mtime)
+{
+  BlendFileIndexHeader header = {};
+  memcpy(header.magic, blend_file_index_magic, sizeof(header.magic));
+  header.version = BLEND_FILE_INDEX_VERSION;
+  header.entries_num = uint32_t(index.entries.size());
+  header.file_size = file_size;
+  header.file_mtime = file_mtime;
+  header.filepath_len = uint32_t(strlen(filepath));
+
+  std::string data;
+  data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+  data.append(filepath, header.filepath_len);
+  for (const BlendFileIndex::Entry &entry : index.entries) {
+    BlendFileIndexEntryHeader entry_header = {};
+    entry_header.idcode = entry.idcode;
+    entry_header.is_asset = entry.is_asset;
+    entry_header.name_len = uint32_t(entry.name.size());
+    data.append(reinterpret_cast<const char *>(&entry_header), sizeof(entry_header));
+    data.append(entry.name);
+  }
+
+  if (!BLI_file_ensure_parent_dir_exists(index_filepath)) {
+    CLOG_WARN(&LOG, "Could not create the directory of index file '%s'", index_filepath);
+    return;
+  }
+
+  /* Write to a unique temporary file first, so that other Blender instances reading the index
+   * never see a partially written file. */
+  static std::atomic<uint32_t> temp_counter = 0;
+  char index_filepath_temp[FILE_MAX];
+  SNPRINTF(index_filepath_temp,
+           "%s.%d.%u.tmp",
+           index_filepath,
+           abs(getpid()),
+           temp_counter.fetch_add(1));
+  const int file = BLI_open(index_filepath_temp, O_BINARY | O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (file == -1) {
+    CLOG_WARN(&LOG, "Could not write index file '%s'", index_filepath);
+    return;
+  }
+  const bool success = write(file, data.data(), data.size()) == data.size();
+  if ((close(file) == -1) || !success ||
+      BLI_rename_overwrite(index_filepath_temp, index_filepath) != 0)
+  {
+    CLOG_WARN(&LOG, "Could not write index file '%s'", index_filepath);
+    BLI_delete(index_filepath_temp, false, false);
+  }
+}
+
+static BlendFileIndex *blend_file_index_from_handle(BlendHandle *bh)
+{
+  FileData *fd = reinterpret_cast<FileData *>(bh);
+  BlendFileIndex *index = MEM_new<BlendFileIndex>(__func__);
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == BLO_CODE_ENDB) {
+      break;
+    }
+    if ((bhead->code & 0xFFFF0000) != 0) {
+      continue;
+    }
+    const short idcode = short(bhead->code);
+    if (!BKE_idtype_idcode_is_valid(idcode) || !BKE_idtype_idcode_is_linkable(idcode)) {
+      continue;
+    }
+    BlendFileIndex::Entry entry;
+    entry.idcode = idcode;
+    entry.is_asset = blo_bhead_id_asset_data_address(fd, bhead) != nullptr;
+    entry.name = blo_bhead_id_name(fd, bhead) + 2;
+    index->entries.append(std::move(entry));
+  }
+  return index;
+}
+
+BlendFileIndex *BLO_blendfile_index_ensure(const char *filepath, BlendFileReadReport *reports)
+{
+  int64_t file_size, file_mtime;
+  char index_filepath[FILE_MAX];
+  /* The file is stat-ed before reading it, so that if it changes in the meantime, the index
+   * doesn't match the new file. */
+  const bool use_index = blend_file_stat(filepath, &file_size, &file_mtime) &&
+                         blend_file_index_filepath(filepath, index_filepath);
+  if (use_index) {
+    if (BlendFileIndex *index = blend_file_index_read(
+            filepath, index_filepath, file_size, file_mtime))
+    {
+      CLOG_INFO(&LOG, 2, "Read index of '%s'", filepath);
+      return index;
+    }
+  }
+
+  BlendHandle *bh = BLO_blendhandle_from_file(filepath, reports);
+  if (bh == nullptr) {
+    return nullptr;
+  }
+  BlendFileIndex *index = blend_file_index_from_handle(bh);
+  BLO_blendhandle_close(bh);
+
+  if (use_index) {
+    CLOG_INFO(&LOG, 2, "Write index of '%s' to '%s'", filepath, index_filepath);
+    blend_file_index_write(*index, filepath, index_filepath, file_size, file_mtime);
+  }
+  return index;
+}
+
+LinkNode *BLO_blendfile_index_get_datablock_names(const BlendFileIndex *index,
+                                                  const int ofblocktype,
+                                                  const bool use_assets_only,
+                                                  int *r_tot_names)
+{
+  LinkNode *names = nullptr;
+  int tot = 0;
+  for (const BlendFileIndex::Entry &entry : index->entries) {
+    if (entry.idcode != ofblocktype || (use_assets_only && !entry.is_asset)) {
+      continue;
+    }
+    BLI_linklist_prepend(&names, BLI_strdup(entry.name.c_str()));
+    tot++;
+  }
+  *r_tot_names = tot;
+  return names;
+}
+
+void BLO_blendfile_index_free(BlendFileIndex *index)
+{
+  MEM_delete(index);
+}
@@ -0,0 +1,108 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+
+#include <xxhash.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "BLI_fileops.h"
+#include "BLI_path_utils.hh"
+#include "BLI_string.h"
+#include "BLI_system.h"
+#include BLI_SYSTEM_PID_H
+
+#include "chunk_store.hh"
+
+/**
+ * Chunks are stored as `<store>/<first two hex digits of the hash>/<hash as hex>`, to avoid
+ * having a huge number of files in a single directory.
+ */
+static void chunk_store_filepath(const char *store_dirpath,
+                                 const BLOChunkHash &hash,
+                                 char r_filepath[FILE_MAX])
+{
+  char name[33];
+  SNPRINTF(name, "%016llx%016llx", (unsigned long long)hash.high, (unsigned long long)hash.low);
+  const char subdir[3] = {name[0], name[1], '\0'};
+  BLI_path_join(r_filepath, FILE_MAX, store_dirpath, subdir, name);
+}
+
+static bool chunk_store_write_file(const char *filepath, const void *data, const size_t len)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (file == -1) {
+    return false;
+  }
+  const bool success = write(file, data, len) == len;
+  return (close(file) != -1) && success;
+}
+
+bool blo_chunk_store_write(const char *store_dirpath,
+                           const void *data,
+                           const size_t len,
+                           BLOChunkHash *r_hash)
+{
+  const XXH128_hash_t xxhash = XXH3_128bits(data, len);
+  r_hash->low = xxhash.low64;
+  r_hash->high = xxhash.high64;
+
+  char filepath[FILE_MAX];
+  chunk_store_filepath(store_dirpath, *r_hash, filepath);
+  if (BLI_exists(filepath)) {
+    /* Content-addressed: an existing chunk with the same hash has the same content. */
+    return true;
+  }
+  if (!BLI_file_ensure_parent_dir_exists(filepath)) {
+    return false;
+  }
+
+  /* Write to a unique temporary file first, so that other writers (threads or processes) never
+   * see a partially written chunk. */
+  static std::atomic<uint32_t> temp_counter = 0;
+  char filepath_temp[FILE_MAX];
+  SNPRINTF(filepath_temp, "%s.%d.%u.tmp", filepath, abs(getpid()), temp_counter.fetch_add(1));
+  if (!chunk_store_write_file(filepath_temp, data, len)) {
+    BLI_delete(filepath_temp, false, false);
+    return false;
+  }
+  if (BLI_rename_overwrite(filepath_temp, filepath) != 0) {
+    BLI_delete(filepath_temp, false, false);
+    /* Another writer may have stored the same chunk in the meantime. */
+    return BLI_exists(filepath);
+  }
+  return true;
+}
+
+bool blo_chunk_store_read(const char *store_dirpath,
+                          const BLOChunkHash &hash,
+                          void *r_data,
+                          const size_t len)
+{
+  char filepath[FILE_MAX];
+  chunk_store_filepath(store_dirpath, hash, filepath);
+
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    return false;
+  }
+  bool success = BLI_file_descriptor_size(file) == len;
+  if (success) {
+    success = BLI_read(file, r_data, len) == int64_t(len);
+  }
+  close(file);
+  return success;
+}
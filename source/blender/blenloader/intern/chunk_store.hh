@@ -0,0 +1,65 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ *
+ * Content-addressed storage of large data blocks outside of the blend-file.
+ *
+ * When writing with #BlendFileWriteParams.chunk_store_dirpath, big #BLO_CODE_DATA blocks are split
+ * in chunks, each stored in the chunk store directory in a file named after the hash of its
+ * content. The blend-file only contains a #BLO_CODE_DREF block listing the chunk hashes, so
+ * chunks that did not change since a previous save (of this file or any other file using the same
+ * store) are not written again. When reading, #BLO_CODE_DREF blocks are replaced by the regular
+ * #BLO_CODE_DATA block they reference.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** Only data blocks at least this big are stored in the chunk store. */
+#define BLO_CHUNK_STORE_MIN_SIZE (256 * 1024)
+/** Size of the chunks data blocks are split into (the last chunk may be smaller). */
+#define BLO_CHUNK_STORE_CHUNK_SIZE (1 << 20)
+/** Maximum length of the chunk store path stored in #BLOChunkRefHeader. */
+#define BLO_CHUNK_STORE_PATH_MAX 1024
+
+struct BLOChunkHash {
+  uint64_t low;
+  uint64_t high;
+};
+
+/**
+ * Content of a #BLO_CODE_DREF block, followed by #BLOChunkRefHeader.chunks_num #BLOChunkHash.
+ * Values are stored in the endianness of the blend-file, like any other block.
+ */
+struct BLOChunkRefHeader {
+  /** Size of the referenced data, i.e. #BHead.len of the #BLO_CODE_DATA block. */
+  uint64_t data_len;
+  uint32_t chunk_size;
+  uint32_t chunks_num;
+  /** Chunk store directory, either absolute or relative to the blend-file (`//` prefixed). */
+  char store_dirpath[BLO_CHUNK_STORE_PATH_MAX];
+};
+
+/**
+ * Add a chunk to the store (nothing is written when it is there already).
+ * Safe to call from multiple threads and processes for the same store.
+ * \return false if the chunk could not be written.
+ */
+bool blo_chunk_store_write(const char *store_dirpath,
+                           const void *data,
+                           size_t len,
+                           BLOChunkHash *r_hash);
+
+/**
+ * Read a chunk of \a len bytes from the store into \a r_data.
+ * \return false if the chunk is missing or doesn't have the expected size.
+ */
+bool blo_chunk_store_read(const char *store_dirpath,
+                          const BLOChunkHash &hash,
+                          void *r_data,
+                          size_t len);
@@ -43,6 +43,7 @@
 #include "DNA_packedFile_types.h"
 #include "DNA_sdna_types.h"
 #include "DNA_sound_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_vfont_types.h"
 #include "DNA_volume_types.h"
 #include "DNA_workspace_types.h"
@@ -50,6 +51,7 @@
 #include "MEM_alloc_string_storage.hh"
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
@@ -58,8 +60,11 @@
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -107,6 +112,7 @@
 #include "SEQ_sequencer.hh"
 #include "SEQ_utils.hh"
 
+#include "chunk_store.hh"
 #include "readfile.hh"
 
 /* Make preferences read-only. */
@@ -177,6 +183,13 @@
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
+/**
+ * Decode (endian switch and DNA reconstruction) the data blocks of a single ID in parallel.
+ * Scanning the #BHead list and reading from the file remain serial, only the CPU-bound
+ * conversion of blocks already loaded in memory is distributed over worker threads.
+ */
+#define USE_PARALLEL_READ_STRUCT
+
 static CLG_LogRef LOG = {"blo.readfile"};
 static CLG_LogRef LOG_UNDO = {"blo.readfile.undo"};
 
@@ -237,6 +250,77 @@ static const char *library_parent_filepath(Library *lib)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Read Phase Statistics
+ * \{ */
+
+/**
+ * Accumulate the duration and the amount of data read during its lifetime into one of the
+ * #BlendFileReadReport.phases, when #FileData.use_phase_stats is set.
+ *
+ * Changes in allocated memory are only measured when \a use_memory is set, since getting the
+ * memory usage is too costly for the stages made of many small steps.
+ */
+class ReadPhaseScope {
+  FileData *fd_;
+  BlendFileReadPhaseStats *stats_ = nullptr;
+  bool use_memory_;
+  double start_time_;
+  uint64_t start_bytes_read_;
+  int64_t start_memory_;
+  int64_t start_memory_blocks_;
+
+ public:
+  ReadPhaseScope(FileData *fd,
+                 BlendFileReadPhaseStats BlendFileReadPhases::*phase,
+                 const bool use_memory = false)
+      : fd_(fd), use_memory_(use_memory)
+  {
+    if (!fd->use_phase_stats) {
+      return;
+    }
+    stats_ = &(fd->reports->phases.*phase);
+    start_bytes_read_ = fd->bytes_read;
+    if (use_memory_) {
+      start_memory_ = int64_t(MEM_get_memory_in_use());
+      start_memory_blocks_ = int64_t(MEM_get_memory_blocks_in_use());
+    }
+    start_time_ = BLI_time_now_seconds();
+  }
+
+  ~ReadPhaseScope()
+  {
+    this->end();
+  }
+
+  /** Stop measuring before the end of the scope, required when the #FileData gets freed. */
+  void end()
+  {
+    if (stats_ == nullptr) {
+      return;
+    }
+    stats_->duration += BLI_time_now_seconds() - start_time_;
+    stats_->bytes_read += fd_->bytes_read - start_bytes_read_;
+    if (use_memory_) {
+      stats_->memory += int64_t(MEM_get_memory_in_use()) - start_memory_;
+      stats_->memory_blocks += int64_t(MEM_get_memory_blocks_in_use()) - start_memory_blocks_;
+    }
+    stats_ = nullptr;
+  }
+};
+
+/** Same as `fd->file->read`, but keeps track of the amount of data read. */
+static int64_t fd_file_read(FileData *fd, void *buffer, const size_t size)
+{
+  const int64_t readsize = fd->file->read(fd->file, buffer, size);
+  if (readsize > 0) {
+    fd->bytes_read += uint64_t(readsize);
+  }
+  return readsize;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name OldNewMap API
  * \{ */
@@ -327,6 +411,139 @@ static void oldnewmap_free(OldNewMap *onm)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Memory-Mapped Data API
+ *
+ * When enabled in the preferences (#UserDef_Experimental.use_mmap_shared_data), large data
+ * blocks of uncompressed files which can be used as they are stored (no endian switch, no DNA
+ * reconstruction and no pointers to remap) are not copied when loading. Implicitly shared arrays
+ * (see #blo_read_shared_impl) reference them directly in the copy-on-write mapping of the file,
+ * which is kept alive until the last of these arrays is freed.
+ *
+ * Any other access to such a block (through #newdataadr) copies it into the #OldNewMap as usual.
+ * \{ */
+
+/** Minimum size (in bytes) of a data block for it to be referenced from the file mapping. */
+#define MMAP_SHARED_DATA_MIN_SIZE (64 * 1024)
+
+/** Owns the file mapping, users are the #FileData and each #MmapDataSharingInfo. */
+class MmapFileSharingInfo : public blender::ImplicitSharingInfo {
+ public:
+  BLI_mmap_file *mmap_file;
+
+  MmapFileSharingInfo(BLI_mmap_file *mmap_file) : mmap_file(mmap_file) {}
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(mmap_file);
+    MEM_delete(this);
+  }
+};
+
+/**
+ * Sharing info of a single array stored in the file mapping. Each array needs its own sharing
+ * info, so that its user count only accounts for the users of that array.
+ */
+class MmapDataSharingInfo : public blender::ImplicitSharingInfo {
+ public:
+  const MmapFileSharingInfo *file_sharing_info;
+
+  MmapDataSharingInfo(const MmapFileSharingInfo *file_sharing_info)
+      : file_sharing_info(file_sharing_info)
+  {
+    file_sharing_info->add_user();
+  }
+
+ private:
+  void delete_data_only() override
+  {
+    if (file_sharing_info) {
+      file_sharing_info->remove_user_and_delete_if_last();
+      file_sharing_info = nullptr;
+    }
+  }
+
+  void delete_self_with_data() override
+  {
+    this->delete_data_only();
+    MEM_delete(this);
+  }
+};
+
+struct MappedDataBlock {
+  void *data;
+  size_t size;
+  int alignment;
+  const char *alloc_name;
+};
+
+struct MappedDataMap {
+  const MmapFileSharingInfo *file_sharing_info;
+  char *memory;
+  size_t length;
+  /** Per file SDNA struct, -1 when not computed yet, see #DNA_struct_contains_pointers. */
+  blender::Array<int8_t> struct_has_pointers;
+  /** Data blocks of the ID being read that were not copied, keyed by their old address. */
+  blender::Map<const void *, MappedDataBlock> blocks;
+};
+
+static MappedDataMap *mapped_datamap_new(const MmapFileSharingInfo *file_sharing_info)
+{
+  MappedDataMap *mdm = MEM_new<MappedDataMap>(__func__);
+  mdm->file_sharing_info = file_sharing_info;
+  mdm->memory = static_cast<char *>(BLI_mmap_get_pointer(file_sharing_info->mmap_file));
+  mdm->length = BLI_mmap_get_length(file_sharing_info->mmap_file);
+  return mdm;
+}
+
+static void mapped_datamap_free(MappedDataMap *mdm)
+{
+  mdm->file_sharing_info->remove_user_and_delete_if_last();
+  MEM_delete(mdm);
+}
+
+/** Forget about the blocks of the ID that was just read, they are only referenced by old addresses
+ * of that ID (same as #oldnewmap_clear, but there is no memory to free). */
+static void mapped_datamap_clear(FileData *fd)
+{
+  if (fd->mapped_datamap) {
+    fd->mapped_datamap->blocks.clear();
+  }
+}
+
+static bool mapped_datamap_struct_has_pointers(MappedDataMap *mdm,
+                                               const SDNA *sdna,
+                                               const int struct_index)
+{
+  if (mdm->struct_has_pointers.is_empty()) {
+    mdm->struct_has_pointers.reinitialize(sdna->structs_num);
+    mdm->struct_has_pointers.fill(-1);
+  }
+  int8_t &has_pointers = mdm->struct_has_pointers[struct_index];
+  if (has_pointers == -1) {
+    has_pointers = DNA_struct_contains_pointers(sdna, struct_index);
+  }
+  return has_pointers;
+}
+
+/**
+ * Copy the mapped block at \a adr (if any) into regular memory and add it to the #OldNewMap,
+ * for code expecting data it owns.
+ */
+static void mapped_datamap_ensure_copied(FileData *fd, const void *adr)
+{
+  std::optional<MappedDataBlock> block = fd->mapped_datamap->blocks.pop_try(adr);
+  if (!block) {
+    return;
+  }
+  void *data = MEM_mallocN_aligned(block->size, block->alignment, block->alloc_name);
+  memcpy(data, block->data, block->size);
+  oldnewmap_insert(fd->datamap, adr, data, 0);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Helper Functions
  * \{ */
@@ -692,6 +909,78 @@ static void bh8_from_bh4(BHead *bhead, BHead4 *bhead4)
   }
 }
 
+/**
+ * Replace a #BLO_CODE_DREF block by the #BLO_CODE_DATA block it references, reading its content
+ * from the chunk store. \a ref_bhead is freed.
+ */
+static BHeadN *get_bhead_from_chunk_store(FileData *fd, BHeadN *ref_bhead)
+{
+  const BHead &bhead = ref_bhead->bhead;
+  BHeadN *new_bhead = nullptr;
+
+  BLOChunkRefHeader *ref = reinterpret_cast<BLOChunkRefHeader *>(ref_bhead + 1);
+  BLOChunkHash *hashes = reinterpret_cast<BLOChunkHash *>(ref + 1);
+  bool is_valid = size_t(bhead.len) >= sizeof(BLOChunkRefHeader);
+  if (is_valid) {
+    if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+      BLI_endian_switch_uint64(&ref->data_len);
+      BLI_endian_switch_uint32(&ref->chunk_size);
+      BLI_endian_switch_uint32(&ref->chunks_num);
+    }
+    is_valid = ref->data_len <= INT_MAX && ref->chunk_size != 0 &&
+               ref->chunks_num == divide_ceil_ul(ref->data_len, ref->chunk_size) &&
+               size_t(bhead.len) ==
+                   sizeof(BLOChunkRefHeader) + sizeof(BLOChunkHash) * size_t(ref->chunks_num);
+  }
+  if (!is_valid) {
+    BLO_reportf_wrap(fd->reports, RPT_ERROR, RPT_("Invalid reference to chunk store data"));
+  }
+  else {
+    ref->store_dirpath[sizeof(ref->store_dirpath) - 1] = '\0';
+    char store_dirpath[FILE_MAX];
+    STRNCPY(store_dirpath, ref->store_dirpath);
+    BLI_path_abs(store_dirpath, fd->relabase);
+
+    new_bhead = static_cast<BHeadN *>(
+        MEM_mallocN(sizeof(BHeadN) + size_t(ref->data_len), "new_bhead"));
+    new_bhead->next = new_bhead->prev = nullptr;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    new_bhead->file_offset = 0; /* don't seek. */
+    new_bhead->has_data = true;
+#endif
+    new_bhead->is_memchunk_identical = false;
+    new_bhead->bhead = bhead;
+    new_bhead->bhead.code = BLO_CODE_DATA;
+    new_bhead->bhead.len = int(ref->data_len);
+
+    for (uint32_t i = 0; i < ref->chunks_num; i++) {
+      BLOChunkHash &hash = hashes[i];
+      if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+        BLI_endian_switch_uint64(&hash.low);
+        BLI_endian_switch_uint64(&hash.high);
+      }
+      const size_t offset = size_t(i) * ref->chunk_size;
+      const size_t len = std::min<size_t>(ref->data_len - offset, ref->chunk_size);
+      if (!blo_chunk_store_read(store_dirpath, hash, POINTER_OFFSET(new_bhead + 1, offset), len)) {
+        BLO_reportf_wrap(fd->reports,
+                         RPT_ERROR,
+                         RPT_("Unable to read data from chunk store '%s'"),
+                         store_dirpath);
+        MEM_freeN(new_bhead);
+        new_bhead = nullptr;
+        break;
+      }
+    }
+  }
+
+  MEM_freeN(ref_bhead);
+  if (new_bhead == nullptr) {
+    /* Same as a truncated file, stop reading. */
+    fd->is_eof = true;
+  }
+  return new_bhead;
+}
+
 static BHeadN *get_bhead(FileData *fd)
 {
   BHeadN *new_bhead = nullptr;
@@ -699,6 +988,8 @@ static BHeadN *get_bhead(FileData *fd)
 
   if (fd) {
     if (!fd->is_eof) {
+      ReadPhaseScope phase(fd, &BlendFileReadPhases::bhead_scan);
+
       /* initializing to zero isn't strictly needed but shuts valgrind up
        * since uninitialized memory gets compared */
       BHead8 bhead8 = {0};
@@ -714,7 +1005,7 @@ static BHeadN *get_bhead(FileData *fd)
        */
       if (fd->flags & FD_FLAGS_FILE_POINTSIZE_IS_4) {
         bhead4.code = BLO_CODE_DATA;
-        readsize = fd->file->read(fd->file, &bhead4, sizeof(bhead4));
+        readsize = fd_file_read(fd, &bhead4, sizeof(bhead4));
 
         if (readsize == sizeof(bhead4) || bhead4.code == BLO_CODE_ENDB) {
           if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
@@ -737,7 +1028,7 @@ static BHeadN *get_bhead(FileData *fd)
       }
       else {
         bhead8.code = BLO_CODE_DATA;
-        readsize = fd->file->read(fd->file, &bhead8, sizeof(bhead8));
+        readsize = fd_file_read(fd, &bhead8, sizeof(bhead8));
 
         if (readsize == sizeof(bhead8) || bhead8.code == BLO_CODE_ENDB) {
           if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
@@ -807,7 +1098,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = bhead;
 
-          readsize = fd->file->read(fd->file, new_bhead + 1, size_t(bhead.len));
+          readsize = fd_file_read(fd, new_bhead + 1, size_t(bhead.len));
 
           if (readsize != bhead.len) {
             fd->is_eof = true;
@@ -818,6 +1109,9 @@ static BHeadN *get_bhead(FileData *fd)
           if (fd->flags & FD_FLAGS_IS_MEMFILE) {
             new_bhead->is_memchunk_identical = ((UndoReader *)fd->file)->memchunk_identical;
           }
+          else if (new_bhead && new_bhead->bhead.code == BLO_CODE_DREF) {
+            new_bhead = get_bhead_from_chunk_store(fd, new_bhead);
+          }
         }
         else {
           fd->is_eof = true;
@@ -901,7 +1195,7 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
     success = false;
   }
   else {
-    if (fd->file->read(fd->file, buf, size_t(new_bhead->bhead.len)) != new_bhead->bhead.len) {
+    if (fd_file_read(fd, buf, size_t(new_bhead->bhead.len)) != new_bhead->bhead.len) {
       success = false;
     }
     if (fd->flags & FD_FLAGS_IS_MEMFILE) {
@@ -950,7 +1244,7 @@ static void decode_blender_header(FileData *fd)
   int64_t readsize;
 
   /* read in the header data */
-  readsize = fd->file->read(fd->file, header, sizeof(header));
+  readsize = fd_file_read(fd, header, sizeof(header));
 
   if (readsize == sizeof(header) && STREQLEN(header, "BLENDER", 7) && ELEM(header[7], '_', '-') &&
       ELEM(header[8], 'v', 'V') &&
@@ -1159,11 +1453,14 @@ static bool is_minversion_older_than_blender(FileData *fd, ReportList *reports)
 
 static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
 {
+  ReadPhaseScope header_phase(fd, &BlendFileReadPhases::header_dna, true);
   decode_blender_header(fd);
 
   if (fd->flags & FD_FLAGS_FILE_OK) {
     const char *error_message = nullptr;
-    if (read_file_dna(fd, &error_message) == false) {
+    const bool is_dna_read = read_file_dna(fd, &error_message);
+    header_phase.end();
+    if (is_dna_read == false) {
       BKE_reportf(
           reports, RPT_ERROR, "Failed to read blend file '%s': %s", fd->relabase, error_message);
       blo_filedata_free(fd);
@@ -1175,6 +1472,7 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
     }
   }
   else {
+    header_phase.end();
     BKE_reportf(
         reports, RPT_ERROR, "Failed to read blend file '%s', not a blend file", fd->relabase);
     blo_filedata_free(fd);
@@ -1191,6 +1489,7 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   char header[7];
   FileReader *rawfile = BLI_filereader_new_file(filedes);
   FileReader *file = nullptr;
+  const MmapFileSharingInfo *mmap_sharing_info = nullptr;
 
   errno = 0;
   /* If opening the file failed or we can't read the header, give up. */
@@ -1215,7 +1514,20 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   /* Check if we have a regular file. */
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     /* Try opening the file with memory-mapped IO. */
-    file = BLI_filereader_new_mmap(filedes);
+#ifndef WIN32
+    /* Not on WIN32: a file with an open mapping can't be replaced, which would break saving. */
+    if (USER_EXPERIMENTAL_TEST(&U, use_mmap_shared_data)) {
+      /* Keep the mapping alive after reading, for data referenced from it (the mapping has to be
+       * writable for this data to be usable like any other, changes are never written back). */
+      if (BLI_mmap_file *mmap_file = BLI_mmap_open_ex(filedes, true)) {
+        file = BLI_filereader_new_mmap_file(mmap_file);
+        mmap_sharing_info = MEM_new<MmapFileSharingInfo>(__func__, mmap_file);
+      }
+    }
+#endif
+    if (file == nullptr) {
+      file = BLI_filereader_new_mmap(filedes);
+    }
     if (file == nullptr) {
       /* `mmap` failed, so just keep using `rawfile`. */
       file = rawfile;
@@ -1246,6 +1558,9 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   FileData *fd = filedata_new(reports);
   fd->file = file;
+  if (mmap_sharing_info) {
+    fd->mapped_datamap = mapped_datamap_new(mmap_sharing_info);
+  }
 
   return fd;
 }
@@ -1271,6 +1586,7 @@ FileData *blo_filedata_from_file(const char *filepath, BlendFileReadReport *repo
   if (fd != nullptr) {
     /* needed for library_append and read_libraries */
     STRNCPY(fd->relabase, filepath);
+    fd->use_phase_stats = (G.debug & G_DEBUG_IO) != 0;
 
     return blo_decode_and_check(fd, reports->reports);
   }
@@ -1379,6 +1695,9 @@ void blo_filedata_free(FileData *fd)
   if (fd->libmap) {
     oldnewmap_free(fd->libmap);
   }
+  if (fd->mapped_datamap) {
+    mapped_datamap_free(fd->mapped_datamap);
+  }
   if (fd->old_idmap_uid != nullptr) {
     BKE_main_idmap_destroy(fd->old_idmap_uid);
   }
@@ -1452,12 +1771,18 @@ short BLO_version_from_file(const char *filepath)
 /* Only direct data-blocks. */
 static void *newdataadr(FileData *fd, const void *adr)
 {
+  if (fd->mapped_datamap) {
+    mapped_datamap_ensure_copied(fd, adr);
+  }
   return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
+  if (fd->mapped_datamap) {
+    mapped_datamap_ensure_copied(fd, adr);
+  }
   return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
 }
 
@@ -1796,6 +2121,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
   void *temp = nullptr;
 
   if (bh->len) {
+    ReadPhaseScope phase(fd, &BlendFileReadPhases::read_struct);
 #ifdef USE_BHEAD_READ_ON_DEMAND
     BHead *bh_orig = bh;
 #endif
@@ -1866,6 +2192,165 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
   return temp;
 }
 
+/**
+ * Keep \a bh in the file mapping instead of reading it, when its data can be used as is.
+ * \return true when the block was handled and must not be read with #read_struct.
+ */
+static bool read_struct_mapped(FileData *fd,
+                               BHead *bh,
+                               const char *blockname,
+                               const int id_type_index)
+{
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  MappedDataMap *mdm = fd->mapped_datamap;
+  if (mdm == nullptr || bh->len < MMAP_SHARED_DATA_MIN_SIZE || bh->old == nullptr) {
+    return false;
+  }
+  if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+    return false;
+  }
+  const BHeadN *new_bhead = BHEADN_FROM_BHEAD(bh);
+  if (new_bhead->has_data || new_bhead->file_offset == 0 ||
+      size_t(new_bhead->file_offset) + size_t(bh->len) > mdm->length)
+  {
+    return false;
+  }
+  if (fd->compflags[bh->SDNAnr] != SDNA_CMP_EQUAL ||
+      mapped_datamap_struct_has_pointers(mdm, fd->filesdna, bh->SDNAnr))
+  {
+    return false;
+  }
+  const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+  void *data = mdm->memory + new_bhead->file_offset;
+  if (uintptr_t(data) % uintptr_t(alignment) != 0) {
+    return false;
+  }
+
+  const MappedDataBlock block{
+      data, size_t(bh->len), alignment, get_alloc_name(fd, bh, blockname, id_type_index)};
+  if (fd->datamap->map.contains(bh->old) || !mdm->blocks.add(bh->old, block)) {
+    CLOG_ERROR(&LOG,
+               "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+               "value (%p) for a given ID.",
+               bh->old);
+  }
+  return true;
+#else
+  UNUSED_VARS(fd, bh, blockname, id_type_index);
+  return false;
+#endif
+}
+
+#ifdef USE_PARALLEL_READ_STRUCT
+
+/**
+ * Minimum amount of data (in bytes) owned by a single ID for its blocks to be decoded in
+ * parallel. Below that, the threading overhead outweighs the gain.
+ */
+#  define PARALLEL_READ_STRUCT_MIN_SIZE (256 * 1024)
+
+/**
+ * Check whether decoding the given block requires its data to be loaded in memory first, i.e.
+ * whether it cannot be read straight from the file into its final allocation.
+ */
+static bool read_struct_needs_full_bhead(const FileData *fd, const BHead *bh)
+{
+  if (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    return true;
+  }
+  return fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL;
+}
+
+/**
+ * Same as calling #read_struct on each block of \a bheads, but the endian switch and DNA
+ * reconstruction of the blocks are done in parallel.
+ *
+ * Everything touching the #FileData state (reading from the file, allocation names storage,
+ * error flags) is done serially, before and after the parallel conversion, so that the result is
+ * exactly the same as with the serial code path.
+ */
+static void read_struct_array_parallel(FileData *fd,
+                                       const blender::Span<BHead *> bheads,
+                                       const char *blockname,
+                                       const int id_type_index,
+                                       blender::MutableSpan<void *> r_data)
+{
+  using namespace blender;
+  BLI_assert(bheads.size() == r_data.size());
+
+  struct DecodeTask {
+    int index;
+    /** Block with its data in memory, may be a temporary copy of the original one. */
+    BHead *bh;
+    const char *alloc_name;
+  };
+  Vector<DecodeTask> tasks;
+  tasks.reserve(bheads.size());
+
+  for (const int i : bheads.index_range()) {
+    BHead *bh = bheads[i];
+    r_data[i] = nullptr;
+    if (bh->len == 0) {
+      continue;
+    }
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+    if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+      if (!read_struct_needs_full_bhead(fd, bh)) {
+        /* Reading directly from the file into the final memory is IO-bound, keep it serial. */
+        r_data[i] = read_struct(fd, bh, blockname, id_type_index);
+        continue;
+      }
+      bh = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(bh == nullptr)) {
+        fd->flags &= ~FD_FLAGS_FILE_OK;
+        continue;
+      }
+    }
+#  endif
+    /* The allocation names storage is not thread-safe, get the name beforehand. */
+    const char *alloc_name = (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) ?
+                                 get_alloc_name(fd, bh, blockname, id_type_index) :
+                                 nullptr;
+    tasks.append({i, bh, alloc_name});
+  }
+
+  ReadPhaseScope phase(fd, &BlendFileReadPhases::read_struct);
+  threading::parallel_for(tasks.index_range(), 1, [&](const IndexRange range) {
+    for (const DecodeTask &task : tasks.as_span().slice(range)) {
+      BHead *bh = task.bh;
+      if (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+        switch_endian_structs(fd->filesdna, bh);
+      }
+      switch (fd->compflags[bh->SDNAnr]) {
+        case SDNA_CMP_REMOVED:
+          break;
+        case SDNA_CMP_NOT_EQUAL:
+          r_data[task.index] = DNA_struct_reconstruct(
+              fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1), task.alloc_name);
+          break;
+        default: {
+          /* SDNA_CMP_EQUAL */
+          const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+          void *temp = MEM_mallocN_aligned(bh->len, alignment, task.alloc_name);
+          memcpy(temp, (bh + 1), bh->len);
+          r_data[task.index] = temp;
+          break;
+        }
+      }
+    }
+  });
+
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+  for (const DecodeTask &task : tasks) {
+    if (task.bh != bheads[task.index]) {
+      MEM_freeN(BHEADN_FROM_BHEAD(task.bh));
+    }
+  }
+#  endif
+}
+
+#endif /* USE_PARALLEL_READ_STRUCT */
+
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
@@ -2469,7 +2954,46 @@ static BHead *read_data_into_datamap(FileData *fd,
 {
   bhead = blo_bhead_next(fd, bhead);
 
+#ifdef USE_PARALLEL_READ_STRUCT
+  /* Scanning the blocks has to remain serial, as it may read from the file. */
+  blender::Vector<BHead *, 16> data_bheads;
+  int64_t data_size = 0;
+  while (bhead && bhead->code == BLO_CODE_DATA) {
+    if (!read_struct_mapped(fd, bhead, allocname, id_type_index)) {
+      data_bheads.append(bhead);
+      data_size += bhead->len;
+    }
+    bhead = blo_bhead_next(fd, bhead);
+  }
+
+  blender::Array<void *, 16> data_array(data_bheads.size());
+  if (data_bheads.size() > 1 && data_size >= PARALLEL_READ_STRUCT_MIN_SIZE) {
+    read_struct_array_parallel(fd, data_bheads, allocname, id_type_index, data_array);
+  }
+  else {
+    for (const int i : data_bheads.index_range()) {
+      data_array[i] = read_struct(fd, data_bheads[i], allocname, id_type_index);
+    }
+  }
+
+  /* Insert in the same order as the serial code, so that error reports are deterministic. */
+  for (const int i : data_bheads.index_range()) {
+    if (data_array[i]) {
+      const bool is_new = oldnewmap_insert(fd->datamap, data_bheads[i]->old, data_array[i], 0);
+      if (!is_new) {
+        CLOG_ERROR(&LOG,
+                   "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+                   "value (%p) for a given ID.",
+                   data_bheads[i]->old);
+      }
+    }
+  }
+#else
   while (bhead && bhead->code == BLO_CODE_DATA) {
+    if (read_struct_mapped(fd, bhead, allocname, id_type_index)) {
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
     void *data = read_struct(fd, bhead, allocname, id_type_index);
     if (data) {
       const bool is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
@@ -2483,6 +3007,7 @@ static BHead *read_data_into_datamap(FileData *fd,
 
     bhead = blo_bhead_next(fd, bhead);
   }
+#endif
 
   return bhead;
 }
@@ -2962,6 +3487,7 @@ static BHead *read_libblock(FileData *fd,
   bhead = read_data_into_datamap(fd, bhead, blockname, id_type_index);
   const bool success = direct_link_id(fd, main, id_tag, id, id_old);
   oldnewmap_clear(fd->datamap);
+  mapped_datamap_clear(fd);
 
   if (!success) {
     /* XXX This is probably working OK currently given the very limited scope of that flag.
@@ -3006,6 +3532,7 @@ BHead *blo_read_asset_data_block(FileData *fd, BHead *bhead, AssetMetaData **r_a
   BKE_asset_metadata_read(&reader, *r_asset_data);
 
   oldnewmap_clear(fd->datamap);
+  mapped_datamap_clear(fd);
 
   return bhead;
 }
@@ -3105,6 +3632,7 @@ static void do_versions_userdef(FileData * /*fd*/, BlendFileData *bfd)
 static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
+  ReadPhaseScope phase(fd, &BlendFileReadPhases::versioning, true);
 
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
@@ -3166,6 +3694,7 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
 static void do_versions_after_linking(FileData *fd, Main *main)
 {
   BLI_assert(fd != nullptr);
+  ReadPhaseScope phase(fd, &BlendFileReadPhases::versioning, true);
 
   CLOG_INFO(&LOG,
             2,
@@ -3239,6 +3768,7 @@ static int lib_link_cb(LibraryIDLinkCallbackData *cb_data)
 
 static void lib_link_all(FileData *fd, Main *bmain)
 {
+  ReadPhaseScope phase(fd, &BlendFileReadPhases::lib_link, true);
   BlendLibReader reader = {fd, bmain};
 
   ID *id;
@@ -3444,6 +3974,7 @@ static BHead *read_userdef(BlendFileData *bfd, FileData *fd, BHead *bhead)
 
   /* free fd->datamap again */
   oldnewmap_clear(fd->datamap);
+  mapped_datamap_clear(fd);
 
   return bhead;
 }
@@ -3578,6 +4109,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+  ReadPhaseScope read_data_phase(fd, &BlendFileReadPhases::read_data, true);
   while (bhead) {
     switch (bhead->code) {
       case BLO_CODE_DATA:
@@ -3632,6 +4164,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       return bfd;
     }
   }
+  read_data_phase.end();
 
   if (is_undo) {
     /* Move the remaining Library IDs and their linked data to the new main.
@@ -3678,7 +4211,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     blo_join_main(&mainlist);
 
     lib_link_all(fd, bfd->main);
-    after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    {
+      ReadPhaseScope phase(fd, &BlendFileReadPhases::after_liblink, true);
+      after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    }
 
     if (is_undo) {
       /* Ensure ID usages of reused 'no undo' IDs remain valid. */
@@ -4347,7 +4883,10 @@ static void library_link_end(Main *mainl, FileData **fd, const int flag)
   }
 
   lib_link_all(*fd, mainvar);
-  after_liblink_merged_bmain_process(mainvar, (*fd)->reports);
+  {
+    ReadPhaseScope phase(*fd, &BlendFileReadPhases::after_liblink, true);
+    after_liblink_merged_bmain_process(mainvar, (*fd)->reports);
+  }
 
   /* Some versioning code does expect some proper userrefcounting, e.g. in conversion from
    * groups to collections... We could optimize out that first call when we are reading a
@@ -5074,6 +5613,18 @@ blender::ImplicitSharingInfoAndData blo_read_shared_impl(
     return *shared_data;
   }
 
+  if (MappedDataMap *mdm = reader->fd->mapped_datamap) {
+    /* The data can be used as stored in the file (see #read_struct_mapped), so there is nothing
+     * left for the callback to do. Reference it in the file mapping instead of copying it. */
+    if (std::optional<MappedDataBlock> block = mdm->blocks.pop_try(old_address)) {
+      const blender::ImplicitSharingInfo *sharing_info = MEM_new<MmapDataSharingInfo>(
+          __func__, mdm->file_sharing_info);
+      const blender::ImplicitSharingInfoAndData shared_data{sharing_info, block->data};
+      reader->shared_data_by_stored_address.add(old_address, shared_data);
+      return shared_data;
+    }
+  }
+
   /* This is the first time this data is loaded. The callback also creates the corresponding
    * sharing info which may be reused later. */
   const blender::ImplicitSharingInfo *sharing_info = read_fn();
@@ -32,6 +32,7 @@ struct DNA_ReconstructInfo;
 struct IDNameLib_Map;
 struct Key;
 struct Main;
+struct MappedDataMap;
 struct MemFile;
 struct Object;
 struct OldNewMap;
@@ -107,6 +108,8 @@ struct FileData {
 
   OldNewMap *datamap;
   OldNewMap *globmap;
+  /** Data blocks kept in the file mapping instead of being read, see #read_struct_mapped. */
+  MappedDataMap *mapped_datamap;
 
   /**
    * Store mapping from old ID pointers (the values they have in the .blend file) to new ones,
@@ -142,6 +145,10 @@ struct FileData {
   IDNameLib_Map *new_idmap_uid;
 
   BlendFileReadReport *reports;
+  /** Gather #BlendFileReadReport.phases statistics, see #G_DEBUG_IO. */
+  bool use_phase_stats;
+  /** Amount of data read from #file so far, in bytes. */
+  uint64_t bytes_read;
 
   /** Opaque handle to the storage system used for non-static allocation strings. */
   void *storage_handle;
@@ -6,6 +6,7 @@
  * \ingroup blenloader
  */
 
+#include <atomic>
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -20,12 +21,17 @@
 #  include <io.h>
 #endif
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -36,10 +42,17 @@
 
 #include "BLI_strict_flags.h" /* Keep last. */
 
+/** Fast compression, cold undo steps are typically compressed right after each undo push. */
+#define MEMFILE_COMPRESS_LEVEL 1
+/** Smaller chunks are not worth compressing. */
+#define MEMFILE_COMPRESS_MIN_SIZE 1024
+
 /* **************** support for memory-write, for undo buffers *************** */
 
 void BLO_memfile_free(MemFile *memfile)
 {
+  BLI_assert_msg(memfile->deferred_write == nullptr,
+                 "Deferred writing of the memfile must be done before freeing it");
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
     if (chunk->is_identical == false) {
       MEM_freeN((void *)chunk->buf);
@@ -97,6 +110,137 @@ void BLO_memfile_clear_future(MemFile *memfile)
   }
 }
 
+void BLO_memfile_compress(const blender::Span<MemFile *> memfiles,
+                          const blender::Span<const MemFile *> memfiles_keep)
+{
+  using namespace blender;
+
+  Set<const char *> bufs_keep;
+  for (const MemFile *memfile : memfiles_keep) {
+    LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+      bufs_keep.add(chunk->buf);
+    }
+  }
+
+  /* Buffers are compressed once, from the chunk owning them. */
+  Vector<MemFileChunk *> owner_chunks;
+  for (MemFile *memfile : memfiles) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      if (!chunk->is_identical && !chunk->is_compressed &&
+          chunk->size >= MEMFILE_COMPRESS_MIN_SIZE && !bufs_keep.contains(chunk->buf))
+      {
+        owner_chunks.append(chunk);
+      }
+    }
+  }
+  if (owner_chunks.is_empty()) {
+    return;
+  }
+
+  Array<char *> compressed_bufs(owner_chunks.size(), nullptr);
+  Array<size_t> compressed_sizes(owner_chunks.size(), 0);
+  threading::parallel_for(owner_chunks.index_range(), 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MemFileChunk *chunk = owner_chunks[i];
+      const size_t bound = ZSTD_compressBound(chunk->size);
+      char *buf = static_cast<char *>(MEM_mallocN(bound, "Chunk buffer (compressed)"));
+      const size_t compressed_size = ZSTD_compress(
+          buf, bound, chunk->buf, chunk->size, MEMFILE_COMPRESS_LEVEL);
+      if (ZSTD_isError(compressed_size) || compressed_size >= chunk->size) {
+        /* Keep data that doesn't compress as is. */
+        MEM_freeN(buf);
+        continue;
+      }
+      compressed_bufs[i] = static_cast<char *>(MEM_reallocN(buf, compressed_size));
+      compressed_sizes[i] = compressed_size;
+    }
+  });
+
+  Map<const char *, int64_t> compressed_index_by_buf;
+  for (const int64_t i : owner_chunks.index_range()) {
+    if (compressed_bufs[i] != nullptr) {
+      compressed_index_by_buf.add_new(owner_chunks[i]->buf, i);
+    }
+  }
+  for (MemFile *memfile : memfiles) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      const int64_t i = compressed_index_by_buf.lookup_default(chunk->buf, -1);
+      if (i == -1) {
+        continue;
+      }
+      if (!chunk->is_identical) {
+        memfile->size -= chunk->size - compressed_sizes[i];
+      }
+      chunk->buf = compressed_bufs[i];
+      chunk->is_compressed = true;
+      chunk->compressed_size = compressed_sizes[i];
+    }
+  }
+  for (const auto item : compressed_index_by_buf.items()) {
+    MEM_freeN(const_cast<char *>(item.key));
+  }
+}
+
+bool BLO_memfile_decompress(const blender::Span<MemFile *> memfiles, MemFile *memfile)
+{
+  using namespace blender;
+
+  Vector<const MemFileChunk *> compressed_chunks;
+  Set<const char *> compressed_bufs_found;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_compressed && compressed_bufs_found.add(chunk->buf)) {
+      compressed_chunks.append(chunk);
+    }
+  }
+  if (compressed_chunks.is_empty()) {
+    return true;
+  }
+
+  Array<char *> bufs(compressed_chunks.size());
+  std::atomic<bool> success = true;
+  threading::parallel_for(compressed_chunks.index_range(), 16, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const MemFileChunk *chunk = compressed_chunks[i];
+      bufs[i] = static_cast<char *>(MEM_mallocN(chunk->size, "Chunk buffer"));
+      const size_t size = ZSTD_decompress(
+          bufs[i], chunk->size, chunk->buf, chunk->compressed_size);
+      if (ZSTD_isError(size) || size != chunk->size) {
+        success.store(false, std::memory_order_relaxed);
+      }
+    }
+  });
+  if (!success) {
+    /* Leave all chunks compressed, the memfile can't be read. */
+    for (char *buf : bufs) {
+      MEM_freeN(buf);
+    }
+    return false;
+  }
+
+  Map<const char *, int64_t> index_by_compressed_buf;
+  for (const int64_t i : compressed_chunks.index_range()) {
+    index_by_compressed_buf.add_new(compressed_chunks[i]->buf, i);
+  }
+  for (MemFile *memfile_iter : memfiles) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile_iter->chunks) {
+      const int64_t i = index_by_compressed_buf.lookup_default(chunk->buf, -1);
+      if (i == -1) {
+        continue;
+      }
+      if (!chunk->is_identical) {
+        memfile_iter->size += chunk->size - chunk->compressed_size;
+      }
+      chunk->buf = bufs[i];
+      chunk->is_compressed = false;
+      chunk->compressed_size = 0;
+    }
+  }
+  for (const auto item : index_by_compressed_buf.items()) {
+    MEM_freeN(const_cast<char *>(item.key));
+  }
+  return true;
+}
+
 void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
@@ -143,11 +287,14 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
   curchunk->is_identical_future = true;
   curchunk->id_session_uid = mem_data->current_id_session_uid;
+  curchunk->is_compressed = false;
+  curchunk->compressed_size = 0;
   BLI_addtail(&memfile->chunks, curchunk);
 
   /* we compare compchunk with buf */
   if (*compchunk_step != nullptr) {
     MemFileChunk *compchunk = *compchunk_step;
+    BLI_assert(!compchunk->is_compressed);
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
@@ -167,6 +314,59 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+bool BLO_memfile_write_id_reuse(MemFileWriteData *mem_data, const uint id_session_uid)
+{
+  const MemFile *reference_memfile = mem_data->reference_memfile;
+  MemFileChunk *ref_chunk = mem_data->id_session_uid_mapping.lookup_default(id_session_uid,
+                                                                            nullptr);
+  if (reference_memfile == nullptr || ref_chunk == nullptr) {
+    return false;
+  }
+
+  MemFile *memfile = mem_data->written_memfile;
+  for (; ref_chunk != nullptr && ref_chunk->id_session_uid == id_session_uid;
+       ref_chunk = static_cast<MemFileChunk *>(ref_chunk->next))
+  {
+    MemFileChunk *curchunk = static_cast<MemFileChunk *>(
+        MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
+    curchunk->size = ref_chunk->size;
+    curchunk->buf = ref_chunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uid = id_session_uid;
+    curchunk->is_compressed = ref_chunk->is_compressed;
+    curchunk->compressed_size = ref_chunk->compressed_size;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    ref_chunk->is_identical_future = true;
+  }
+  /* Continue comparing from the chunk following this ID, as #BLO_memfile_chunk_add would. */
+  mem_data->reference_current_chunk = ref_chunk;
+
+  /* Data shared with the previous step is not part of the chunks, add it again. */
+  const MemFileSharedStorage *reference_storage = reference_memfile->shared_storage;
+  if (reference_storage == nullptr) {
+    return true;
+  }
+  const blender::Vector<std::pair<const void *, size_t>> *shared_data =
+      reference_storage->data_by_id_session_uid.lookup_ptr(id_session_uid);
+  if (shared_data == nullptr) {
+    return true;
+  }
+  if (memfile->shared_storage == nullptr) {
+    memfile->shared_storage = MEM_new<MemFileSharedStorage>(__func__);
+  }
+  for (const auto &[data, approximate_size] : *shared_data) {
+    const blender::ImplicitSharingInfo *sharing_info = reference_storage->map.lookup(data);
+    if (memfile->shared_storage->map.add(data, sharing_info)) {
+      sharing_info->add_user();
+      memfile->size += approximate_size / size_t(sharing_info->strong_users());
+    }
+  }
+  memfile->shared_storage->data_by_id_session_uid.add(id_session_uid, *shared_data);
+  return true;
+}
+
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
 {
   Main *bmain_undo = nullptr;
@@ -242,6 +442,8 @@ static int64_t undo_read(FileReader *reader, void *buffer, size_t size)
         readsize = chunk->size - chunkoffset;
       }
 
+      /* Compressed steps are decompressed before being read. */
+      BLI_assert(!chunk->is_compressed);
       memcpy(POINTER_OFFSET(buffer, totread), chunk->buf + chunkoffset, readsize);
       totread += readsize;
       undo->reader.offset += (off64_t)readsize;
@@ -87,6 +87,7 @@
 #include "DNA_key_types.h"
 #include "DNA_sdna_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -94,10 +95,13 @@
 #include "BLI_implicit_sharing.hh"
 #include "BLI_link_utils.h"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_set.hh"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -128,6 +132,7 @@
 #include "BLO_undofile.hh"
 #include "BLO_writefile.hh"
 
+#include "chunk_store.hh"
 #include "readfile.hh"
 
 #include <zstd.h>
@@ -151,6 +156,13 @@ static CLG_LogRef LOG = {"blo.writefile"};
 /** Use if we want to store how many bytes have been written to the file. */
 // #define USE_WRITE_DATA_LEN
 
+/**
+ * Serialize IDs of types flagged with #IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE in parallel when
+ * saving to a file. Each ID is written into its own memory buffer, buffers are then appended to
+ * the file in the same order as the serial code.
+ */
+#define USE_PARALLEL_WRITE_ID
+
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
@@ -204,6 +216,34 @@ bool RawWriteWrap::write(const void *buf, size_t buf_len)
   return ::write(file_handle, buf, buf_len) == buf_len;
 }
 
+#ifdef USE_PARALLEL_WRITE_ID
+/** Keep all written data in memory, see #write_id_batch_parallel. */
+class BufferWriteWrap : public WriteWrap {
+ public:
+  blender::Vector<uchar> data;
+
+  BufferWriteWrap()
+  {
+    /* Already buffered. */
+    use_buf = false;
+  }
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    data.extend(blender::Span<uchar>(static_cast<const uchar *>(buf), int64_t(buf_len)));
+    return true;
+  }
+};
+#endif
+
 class ZstdWriteWrap : public WriteWrap {
   WriteWrap &base_wrap;
 
@@ -399,6 +439,13 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
 /** \name Write Data Type & Functions
  * \{ */
 
+struct WriteChunkStore {
+  /** Absolute path of the directory to write chunks to. */
+  char dirpath[FILE_MAX];
+  /** Path of the directory stored in the file, relative to it when possible. */
+  char dirpath_stored[BLO_CHUNK_STORE_PATH_MAX];
+};
+
 struct WriteData {
   const SDNA *sdna;
 
@@ -442,6 +489,23 @@ struct WriteData {
    */
   blender::Set<const void *> per_id_written_shared_addresses;
 
+  /**
+   * Large data blocks are written to this chunk store instead of the file when set
+   * (see #BlendFileWriteParams.chunk_store_dirpath).
+   */
+  const WriteChunkStore *chunk_store;
+
+  /**
+   * Only record the addresses of the written blocks here, without writing anything. Used to
+   * match the blocks of an ID with the ones of its copy, see #BLO_memfile_write_deferred.
+   */
+  blender::Vector<const void *> *recorded_addresses;
+  /**
+   * Replace the addresses of the written blocks and the pointers they contain, so that a copy of
+   * an ID is written with the addresses of the original one (see #BLO_memfile_write_deferred).
+   */
+  blender::Map<const void *, const void *> *address_map;
+
   /** #MemFile writing (used for undo). */
   MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
@@ -719,6 +783,101 @@ static bool write_at_address_validate(WriteData *wd, int filecode, const void *a
   return true;
 }
 
+/**
+ * Write \a data as a reference to chunks in the chunk store (see #BLO_CODE_DREF).
+ * \return false if that's not possible, the data should be written in the file then.
+ */
+static bool write_bhead_data_to_chunk_store(WriteData *wd, const BHead *bh, const void *data)
+{
+  const WriteChunkStore *chunk_store = wd->chunk_store;
+  const size_t data_len = size_t(bh->len);
+  const uint32_t chunks_num = uint32_t(divide_ceil_ul(data_len, BLO_CHUNK_STORE_CHUNK_SIZE));
+  const size_t ref_len = sizeof(BLOChunkRefHeader) + sizeof(BLOChunkHash) * chunks_num;
+
+  BLOChunkRefHeader *ref = static_cast<BLOChunkRefHeader *>(MEM_callocN(ref_len, __func__));
+  ref->data_len = data_len;
+  ref->chunk_size = BLO_CHUNK_STORE_CHUNK_SIZE;
+  ref->chunks_num = chunks_num;
+  STRNCPY(ref->store_dirpath, chunk_store->dirpath_stored);
+  BLOChunkHash *hashes = reinterpret_cast<BLOChunkHash *>(ref + 1);
+
+  for (uint32_t i = 0; i < chunks_num; i++) {
+    const size_t offset = size_t(i) * BLO_CHUNK_STORE_CHUNK_SIZE;
+    const size_t len = std::min<size_t>(data_len - offset, BLO_CHUNK_STORE_CHUNK_SIZE);
+    if (!blo_chunk_store_write(
+            chunk_store->dirpath, POINTER_OFFSET(data, offset), len, &hashes[i]))
+    {
+      CLOG_WARN(&LOG,
+                "Failed to write to chunk store '%s', storing data in the file",
+                chunk_store->dirpath);
+      MEM_freeN(ref);
+      return false;
+    }
+  }
+
+  BHead bh_ref = *bh;
+  bh_ref.code = BLO_CODE_DREF;
+  bh_ref.len = int(ref_len);
+  mywrite(wd, &bh_ref, sizeof(BHead));
+  mywrite(wd, ref, ref_len);
+
+  MEM_freeN(ref);
+  return true;
+}
+
+static void write_address_remap_cb(void **pointer, void *user_data)
+{
+  const blender::Map<const void *, const void *> &address_map =
+      *static_cast<const blender::Map<const void *, const void *> *>(user_data);
+  *pointer = const_cast<void *>(address_map.lookup_default(*pointer, *pointer));
+}
+
+/** Write a block with the addresses replaced according to #WriteData.address_map. */
+static void write_bhead_data_remapped(WriteData *wd, const BHead *bh, const void *data)
+{
+  blender::Map<const void *, const void *> &address_map = *wd->address_map;
+  BHead bh_remapped = *bh;
+  bh_remapped.old = address_map.lookup_default(bh->old, bh->old);
+  mywrite(wd, &bh_remapped, sizeof(BHead));
+
+  if (bh->SDNAnr == SDNA_RAW_DATA_STRUCT_INDEX ||
+      !DNA_struct_contains_pointers(wd->sdna, bh->SDNAnr))
+  {
+    mywrite(wd, data, size_t(bh->len));
+    return;
+  }
+
+  char *data_remapped = static_cast<char *>(MEM_mallocN(size_t(bh->len), __func__));
+  memcpy(data_remapped, data, size_t(bh->len));
+  const int struct_size = DNA_struct_size(wd->sdna, bh->SDNAnr);
+  for (int i = 0; i < bh->nr; i++) {
+    DNA_struct_foreach_pointer(
+        wd->sdna, bh->SDNAnr, data_remapped + i * struct_size, write_address_remap_cb, &address_map);
+  }
+  mywrite(wd, data_remapped, size_t(bh->len));
+  MEM_freeN(data_remapped);
+}
+
+/** Write a block header followed by its \a data. */
+static void write_bhead_data(WriteData *wd, const BHead *bh, const void *data)
+{
+  if (wd->recorded_addresses) {
+    wd->recorded_addresses->append(bh->old);
+    return;
+  }
+  if (wd->address_map) {
+    write_bhead_data_remapped(wd, bh, data);
+    return;
+  }
+  if (wd->chunk_store && bh->code == BLO_CODE_DATA && bh->len >= BLO_CHUNK_STORE_MIN_SIZE) {
+    if (write_bhead_data_to_chunk_store(wd, bh, data)) {
+      return;
+    }
+  }
+  mywrite(wd, bh, sizeof(BHead));
+  mywrite(wd, data, size_t(bh->len));
+}
+
 static void writestruct_at_address_nr(
     WriteData *wd, int filecode, const int struct_nr, int nr, const void *adr, const void *data)
 {
@@ -746,8 +905,7 @@ static void writestruct_at_address_nr(
     return;
   }
 
-  mywrite(wd, &bh, sizeof(BHead));
-  mywrite(wd, data, size_t(bh.len));
+  write_bhead_data(wd, &bh, data);
 }
 
 static void writestruct_nr(
@@ -787,8 +945,7 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = SDNA_RAW_DATA_STRUCT_INDEX;
   bh.len = int(len);
 
-  mywrite(wd, &bh, sizeof(BHead));
-  mywrite(wd, adr, len);
+  write_bhead_data(wd, &bh, adr);
 }
 
 /**
@@ -1288,6 +1445,288 @@ static int write_id_direct_linked_data_process_cb(LibraryIDLinkCallbackData *cb_
   return IDWALK_RET_NOP;
 }
 
+#ifdef USE_PARALLEL_WRITE_ID
+
+/**
+ * Maximum number of IDs buffered in memory at once before being written to the file, this limits
+ * the memory overhead of writing in parallel.
+ */
+#  define PARALLEL_WRITE_ID_BATCH_SIZE 64
+
+/**
+ * Write the given IDs (all of the same \a id_type), as #write_file_handle would do with each of
+ * them, but calling their #IDTypeInfo.blend_write in parallel.
+ */
+static void write_id_batch_parallel(WriteData *wd,
+                                    const IDTypeInfo *id_type,
+                                    const blender::Span<ID *> ids)
+{
+  using namespace blender;
+  BLI_assert(!wd->use_memfile);
+  BLI_assert(id_type->flags & IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE);
+
+  Array<BufferWriteWrap> buffers(ids.size());
+  threading::parallel_for(ids.index_range(), 1, [&](const IndexRange range) {
+    BLO_Write_IDBuffer *id_buffer = BLO_write_allocate_id_buffer();
+    id_buffer_init_for_id_type(id_buffer, id_type);
+    for (const int i : range) {
+      ID *id = ids[i];
+      WriteData *id_wd = writedata_new(&buffers[i]);
+      id_wd->chunk_store = wd->chunk_store;
+      BlendWriter writer = {id_wd};
+
+      mywrite_id_begin(id_wd, id);
+      id_buffer_init_from_id(id_buffer, id, false);
+      id_type->blend_write(&writer, static_cast<ID *>(id_buffer->temp_id), id);
+      mywrite_id_end(id_wd, id);
+
+      writedata_free(id_wd);
+    }
+    BLO_write_destroy_id_buffer(&id_buffer);
+  });
+
+  for (const BufferWriteWrap &buffer : buffers) {
+    if (!buffer.data.is_empty()) {
+      mywrite(wd, buffer.data.data(), size_t(buffer.data.size()));
+    }
+  }
+}
+
+#endif /* USE_PARALLEL_WRITE_ID */
+
+/**
+ * Reuse what was stored for \a id in the previous undo step instead of writing it again, when it
+ * is known to be unchanged since then (see #IDTYPE_FLAGS_UNDO_CHANGES_ARE_TAGGED).
+ *
+ * \return false if the ID has to be written.
+ */
+static bool write_id_reuse_unchanged_memfile(WriteData *wd, ID *id, const IDTypeInfo *id_type)
+{
+  BLI_assert(wd->use_memfile);
+  if (!USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids)) {
+    return false;
+  }
+  if ((id_type->flags & IDTYPE_FLAGS_UNDO_CHANGES_ARE_TAGGED) == 0 ||
+      id->recalc_after_undo_push != 0)
+  {
+    return false;
+  }
+  /* Data of the previous ID has to be in its own chunks already. */
+  BLI_assert(wd->buffer.used_len == 0);
+  if (!BLO_memfile_write_id_reuse(&wd->mem, id->session_uid)) {
+    return false;
+  }
+  /* Same as #id_buffer_init_from_id. */
+  id->recalc_up_to_undo_push = 0;
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Deferred Undo Writing
+ *
+ * When writing an undo step with deferred writing, changed IDs of types that can be written
+ * independently of the rest of Main (#IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE) are not written
+ * directly. Instead a copy of them is stored in the #MemFile (cheap, since their arrays are
+ * implicitly shared), and #BLO_memfile_write_deferred writes them later, typically from a worker
+ * thread, inserting their chunks where the ID would have been written.
+ *
+ * The copy doesn't have the same addresses as the original ID for the data it doesn't share with
+ * it. Writing it as is would make its chunks differ from the ones of the previous undo step even
+ * when nothing changed, so the blocks of the original ID are recorded when the copy is made, and
+ * the copy is written with the addresses of the matching blocks of the original.
+ * \{ */
+
+struct MemFileDeferredID {
+  /** Copy of the ID taken when the undo step was written, owned by this struct. */
+  ID *id_copy;
+  /** Address of the original ID, stored as the old address in the undo step. */
+  const ID *id_address;
+  /** Values of the original ID, which may differ in its copy. */
+  int tag;
+  int recalc_up_to_undo_push;
+  /** Chunk after which the chunks of this ID are inserted, nullptr to insert them first. */
+  MemFileChunk *insert_after;
+  /** Addresses of the blocks written for the original ID, see #write_id_record_addresses. */
+  blender::Vector<const void *> addresses;
+};
+
+struct MemFileDeferredWrite {
+  /** The memfile the deferred IDs are compared with, as in #MemFileWriteData. */
+  MemFile *reference_memfile;
+  blender::Vector<MemFileDeferredID> ids;
+  /**
+   * Set by #BLO_memfile_write_deferred. The copies are freed later, from the main thread, by
+   * #BLO_memfile_write_deferred_end.
+   */
+  bool is_written;
+};
+
+/**
+ * Get the addresses of the blocks #IDTypeInfo.blend_write writes for \a id in an undo step,
+ * without writing anything. Data stored by reference in undo steps (see #BLO_write_shared) is
+ * skipped, since it is the same for the ID and its copies.
+ */
+static blender::Vector<const void *> write_id_record_addresses(ID *id, const ID *id_address)
+{
+  blender::Vector<const void *> addresses;
+  const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
+
+  WriteData *wd = writedata_new(nullptr);
+  wd->use_memfile = true;
+  wd->recorded_addresses = &addresses;
+  BlendWriter writer = {wd};
+  BLO_Write_IDBuffer *id_buffer = BLO_write_allocate_id_buffer();
+  id_buffer_init_for_id_type(id_buffer, id_type);
+  id_buffer_init_from_id(id_buffer, id, false);
+  id_type->blend_write(&writer, id_buffer->temp_id, id_address);
+  BLO_write_destroy_id_buffer(&id_buffer);
+  writedata_free(wd);
+
+  return addresses;
+}
+
+/**
+ * Store a copy of \a id to write it later with #BLO_memfile_write_deferred.
+ *
+ * \return false if the ID has to be written now.
+ */
+static bool write_id_defer_memfile(WriteData *wd, ID *id, const IDTypeInfo *id_type)
+{
+  BLI_assert(wd->use_memfile);
+  MemFile *memfile = wd->mem.written_memfile;
+  if (memfile->deferred_write == nullptr) {
+    return false;
+  }
+  if ((id_type->flags & IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE) == 0 ||
+      id_type->blend_write == nullptr || ID_IS_LINKED(id) || ID_IS_OVERRIDE_LIBRARY(id))
+  {
+    return false;
+  }
+  /* Data of the previous ID has to be in its own chunks already. */
+  BLI_assert(wd->buffer.used_len == 0);
+
+  /* Same as #id_buffer_init_from_id. */
+  id->recalc_up_to_undo_push = id->recalc_after_undo_push;
+  id->recalc_after_undo_push = 0;
+
+  MemFileDeferredID deferred_id;
+  deferred_id.id_copy = BKE_id_copy_ex(nullptr, id, nullptr, LIB_ID_COPY_LOCALIZE);
+  /* Used to find the chunks of this ID in the reference memfile, and by undo reading. */
+  deferred_id.id_copy->session_uid = id->session_uid;
+  deferred_id.id_address = id;
+  deferred_id.tag = id->tag;
+  deferred_id.recalc_up_to_undo_push = id->recalc_up_to_undo_push;
+  deferred_id.insert_after = static_cast<MemFileChunk *>(memfile->chunks.last);
+  deferred_id.addresses = write_id_record_addresses(id, id);
+  memfile->deferred_write->ids.append(std::move(deferred_id));
+  return true;
+}
+
+void BLO_memfile_write_deferred(MemFile *memfile)
+{
+  MemFileDeferredWrite *deferred_write = memfile->deferred_write;
+  if (deferred_write == nullptr || deferred_write->is_written) {
+    return;
+  }
+  deferred_write->is_written = true;
+
+  /* IDs are written to their own memfile first, since the chunks have to be inserted in the
+   * middle of the existing ones. */
+  MemFile id_memfile = {};
+  WriteData *wd = mywrite_begin(nullptr, deferred_write->reference_memfile, &id_memfile);
+  BlendWriter writer = {wd};
+  BLO_Write_IDBuffer *id_buffer = BLO_write_allocate_id_buffer();
+
+  const MemFileChunk *insert_after_prev = nullptr;
+  MemFileChunk *last_inserted = nullptr;
+  for (const MemFileDeferredID &deferred_id : deferred_write->ids) {
+    ID *id = deferred_id.id_copy;
+    const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
+    id_buffer_init_for_id_type(id_buffer, id_type);
+
+    /* Blocks are written in the same order for the copy as for the original ID. If that's not
+     * the case, writing the copy as is is still correct, its chunks just differ from the ones of
+     * the previous undo step. */
+    blender::Map<const void *, const void *> address_map;
+    const blender::Vector<const void *> copy_addresses = write_id_record_addresses(
+        id, deferred_id.id_address);
+    if (copy_addresses.size() == deferred_id.addresses.size()) {
+      for (const int i : copy_addresses.index_range()) {
+        if (copy_addresses[i] != deferred_id.addresses[i]) {
+          address_map.add(copy_addresses[i], deferred_id.addresses[i]);
+        }
+      }
+    }
+
+    mywrite_id_begin(wd, id);
+    wd->address_map = &address_map;
+    id_buffer_init_from_id(id_buffer, id, true);
+    ID *temp_id = id_buffer->temp_id;
+    temp_id->tag = deferred_id.tag & ID_TAG_KEEP_ON_UNDO;
+    temp_id->recalc_up_to_undo_push = deferred_id.recalc_up_to_undo_push;
+    id_type->blend_write(&writer, temp_id, deferred_id.id_address);
+    mywrite_id_end(wd, id);
+    wd->address_map = nullptr;
+
+    /* Consecutive deferred IDs share the same insertion point, keep their order. */
+    MemFileChunk *insert_after = (last_inserted != nullptr &&
+                                  deferred_id.insert_after == insert_after_prev) ?
+                                     last_inserted :
+                                     deferred_id.insert_after;
+    insert_after_prev = deferred_id.insert_after;
+    while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&id_memfile.chunks))) {
+      BLI_insertlinkafter(&memfile->chunks, insert_after, chunk);
+      insert_after = chunk;
+    }
+    last_inserted = insert_after;
+  }
+
+  BLO_write_destroy_id_buffer(&id_buffer);
+  mywrite_end(wd);
+
+  memfile->size += id_memfile.size;
+  if (MemFileSharedStorage *id_storage = id_memfile.shared_storage) {
+    if (memfile->shared_storage == nullptr) {
+      memfile->shared_storage = MEM_new<MemFileSharedStorage>(__func__);
+    }
+    for (const auto item : id_storage->map.items()) {
+      if (!memfile->shared_storage->map.add(item.key, item.value)) {
+        /* Already owned by the undo step. */
+        item.value->remove_user_and_delete_if_last();
+      }
+    }
+    id_storage->map.clear();
+    for (auto &&item : id_storage->data_by_id_session_uid.items()) {
+      memfile->shared_storage->data_by_id_session_uid.add_overwrite(item.key,
+                                                                    std::move(item.value));
+    }
+  }
+  BLO_memfile_free(&id_memfile);
+}
+
+void BLO_memfile_write_deferred_end(MemFile *memfile)
+{
+  MemFileDeferredWrite *deferred_write = memfile->deferred_write;
+  if (deferred_write == nullptr) {
+    return;
+  }
+  BLI_assert(deferred_write->is_written);
+  memfile->deferred_write = nullptr;
+
+  for (const MemFileDeferredID &deferred_id : deferred_write->ids) {
+    BKE_id_free(nullptr, deferred_id.id_copy);
+  }
+  MEM_delete(deferred_write);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name File Writing (Private)
+ * \{ */
+
 /**
  * When #MemFile arguments are non-null, this is a file-safe to memory.
  *
@@ -1300,7 +1739,8 @@ static bool write_file_handle(Main *mainvar,
                               MemFile *current,
                               int write_flags,
                               bool use_userdef,
-                              const BlendThumbnail *thumb)
+                              const BlendThumbnail *thumb,
+                              const WriteChunkStore *chunk_store)
 {
   BHead bhead;
   ListBase mainlist;
@@ -1310,6 +1750,10 @@ static bool write_file_handle(Main *mainvar,
   wd = mywrite_begin(ww, compare, current);
   BlendWriter writer = {wd};
 
+  if (!wd->use_memfile) {
+    wd->chunk_store = chunk_store;
+  }
+
   /* Clear 'directly linked' flag for all linked data, these are not necessarily valid/up-to-date
    * info, they will be re-generated while write code is processing local IDs below. */
   if (!wd->use_memfile) {
@@ -1395,6 +1839,12 @@ static bool write_file_handle(Main *mainvar,
       const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
       id_buffer_init_for_id_type(id_buffer, id_type);
 
+#ifdef USE_PARALLEL_WRITE_ID
+      const bool use_parallel_write = !wd->use_memfile && id_type->blend_write != nullptr &&
+                                      (id_type->flags & IDTYPE_FLAGS_BLEND_WRITE_THREADSAFE);
+      blender::Vector<ID *, PARALLEL_WRITE_ID_BATCH_SIZE> parallel_write_ids;
+#endif
+
       for (; id; id = static_cast<ID *>(id->next)) {
         /* We should never attempt to write non-regular IDs
          * (i.e. all kind of temp/runtime ones). */
@@ -1454,6 +1904,28 @@ static bool write_file_handle(Main *mainvar,
                                       IDWALK_READONLY | IDWALK_INCLUDE_UI);
         }
 
+#ifdef USE_PARALLEL_WRITE_ID
+        if (use_parallel_write) {
+          if (!do_override) {
+            parallel_write_ids.append(id);
+            if (parallel_write_ids.size() == PARALLEL_WRITE_ID_BATCH_SIZE) {
+              write_id_batch_parallel(wd, id_type, parallel_write_ids);
+              parallel_write_ids.clear();
+            }
+            continue;
+          }
+          /* Keep the same order as the serial code. */
+          write_id_batch_parallel(wd, id_type, parallel_write_ids);
+          parallel_write_ids.clear();
+        }
+#endif
+
+        if (wd->use_memfile && (write_id_reuse_unchanged_memfile(wd, id, id_type) ||
+                                write_id_defer_memfile(wd, id, id_type)))
+        {
+          continue;
+        }
+
         if (do_override) {
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
@@ -1473,6 +1945,12 @@ static bool write_file_handle(Main *mainvar,
         mywrite_id_end(wd, id);
       }
 
+#ifdef USE_PARALLEL_WRITE_ID
+      if (use_parallel_write) {
+        write_id_batch_parallel(wd, id_type, parallel_write_ids);
+      }
+#endif
+
       mywrite_flush(wd);
     }
   } while ((bmain != override_storage) && (bmain = override_storage));
@@ -1718,9 +2196,30 @@ static bool BLO_write_file_impl(Main *mainvar,
     }
   }
 
+  /* Chunk store, the path is stored relative to the file when possible so that both can be moved
+   * together. */
+  WriteChunkStore chunk_store;
+  const bool use_chunk_store = params->chunk_store_dirpath && params->chunk_store_dirpath[0];
+  if (use_chunk_store) {
+    STRNCPY(chunk_store.dirpath, params->chunk_store_dirpath);
+    BLI_path_abs(chunk_store.dirpath, filepath);
+    char dirpath_stored[FILE_MAX];
+    STRNCPY(dirpath_stored, chunk_store.dirpath);
+    if (remap_mode != BLO_WRITE_PATH_REMAP_ABSOLUTE) {
+      BLI_path_rel(dirpath_stored, filepath);
+    }
+    STRNCPY(chunk_store.dirpath_stored, dirpath_stored);
+  }
+
   /* Actual file writing. */
-  const bool err = write_file_handle(
-      mainvar, &ww, nullptr, nullptr, write_flags, use_userdef, thumb);
+  const bool err = write_file_handle(mainvar,
+                                     &ww,
+                                     nullptr,
+                                     nullptr,
+                                     write_flags,
+                                     use_userdef,
+                                     thumb,
+                                     use_chunk_store ? &chunk_store : nullptr);
 
   ww.close();
 
@@ -1777,12 +2276,26 @@ bool BLO_write_file(Main *mainvar,
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
-bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
+bool BLO_write_file_mem(Main *mainvar,
+                        MemFile *compare,
+                        MemFile *current,
+                        int write_flags,
+                        const bool use_deferred_write)
 {
   bool use_userdef = false;
 
+  if (use_deferred_write) {
+    current->deferred_write = MEM_new<MemFileDeferredWrite>(__func__);
+    current->deferred_write->reference_memfile = compare;
+  }
+
   const bool err = write_file_handle(
-      mainvar, nullptr, compare, current, write_flags, use_userdef, nullptr);
+      mainvar, nullptr, compare, current, write_flags, use_userdef, nullptr, nullptr);
+
+  if (current->deferred_write && current->deferred_write->ids.is_empty()) {
+    MEM_delete(current->deferred_write);
+    current->deferred_write = nullptr;
+  }
 
   return (err == 0);
 }
@@ -1965,6 +2478,10 @@ void BLO_write_shared(BlendWriter *writer,
     return;
   }
   if (BLO_write_is_undo(writer)) {
+    if (writer->wd->recorded_addresses && sharing_info != nullptr) {
+      /* Stored by reference in the undo step, see below. */
+      return;
+    }
     MemFile &memfile = *writer->wd->mem.written_memfile;
     if (sharing_info != nullptr) {
       if (memfile.shared_storage == nullptr) {
@@ -1975,6 +2492,9 @@ void BLO_write_shared(BlendWriter *writer,
         sharing_info->add_user();
         /* This size is an estimate, but good enough to count data with many users less. */
         memfile.size += approximate_size_in_bytes / sharing_info->strong_users();
+        memfile.shared_storage->data_by_id_session_uid
+            .lookup_or_add_default(writer->wd->mem.current_id_session_uid)
+            .append({data, approximate_size_in_bytes});
         return;
       }
     }
@@ -72,6 +72,14 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations of the given ID for update, when only its own dependencies changed (for example
+ * the target of a modifier). With the experimental incremental relations update only the
+ * relations of this object are built again, otherwise it's the same as
+ * #DEG_relations_tag_update.
+ */
+void DEG_id_relations_tag_update(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
@@ -42,6 +42,12 @@ void DEG_stats_simple(const Depsgraph *graph,
                       size_t *r_operations,
                       size_t *r_relations);
 
+/**
+ * Print the total memory used by the evaluated data of the depsgraph, followed by the
+ * \a max_ids_num data-blocks using most of it. See #DEG_get_evaluated_memory_for_id.
+ */
+void DEG_debug_print_evaluated_memory(const Depsgraph *graph, int max_ids_num);
+
 /* ************************************************ */
 /* Diagram-Based Graph Debugging */
 
@@ -52,6 +58,19 @@ void DEG_debug_stats_gnuplot(const Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Trace */
+
+/**
+ * Start recording the evaluation of every operation of all dependency graphs (with its thread,
+ * ID and operation code), to be written to \a filepath by #DEG_debug_trace_end.
+ * The file uses the Chrome trace-event JSON format, which can be opened in `chrome://tracing`
+ * or Perfetto (`ui.perfetto.dev`).
+ */
+void DEG_debug_trace_begin(const char *filepath);
+/** Stop recording and write the trace file. Does nothing when no trace is being recorded. */
+void DEG_debug_trace_end();
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -73,6 +73,15 @@ void DEG_get_customdata_mask_for_object(const Depsgraph *graph,
                                         Object *object,
                                         CustomData_MeshMasks *r_mask);
 
+/**
+ * Get the memory used by the evaluated data of the given ID (like the evaluated geometry of an
+ * object) as of its last evaluation, in bytes. Data shared with other IDs is included.
+ * Zero when the ID is not in the graph or was not evaluated yet.
+ *
+ * This is counted on request, so it adds no cost to the evaluation.
+ */
+int64_t DEG_get_evaluated_memory_for_id(const Depsgraph *graph, const ID *id);
+
 /**
  * Get scene at its evaluated state.
  *
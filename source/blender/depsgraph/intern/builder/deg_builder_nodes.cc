@@ -15,9 +15,11 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -428,41 +430,32 @@ void DepsgraphNodeBuilder::begin_build()
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
  * the code to access the builder's data more easily. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::id_cow_pointer_needs_update(ID *id_pointer)
 {
   if (id_pointer->orig_id == nullptr) {
-    /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
-     * owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    IDNode *id_node = find_id_node(id_pointer);
-    if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
-  }
-  else {
-    /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
+    /* The evaluated ID uses a non-cow ID, if that ID has an evaluated copy in current depsgraph
      * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
-     * of evaluated depsgraph are still valid pointers, they are freed later (typically during
-     * destruction of the builder itself). */
-    IDNode *id_node = find_id_node(id_pointer->orig_id);
-    if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
+    IDNode *id_node = find_id_node(id_pointer);
+    return id_node != nullptr && id_node->id_cow != nullptr;
   }
-  return IDWALK_RET_NOP;
+  /* The evaluated ID uses an evaluated ID, if that evaluated copy is removed from current
+   * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+  /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
+   * of evaluated depsgraph are still valid pointers, they are freed later (typically during
+   * destruction of the builder itself). */
+  IDNode *id_node = find_id_node(id_pointer->orig_id);
+  return id_node == nullptr;
 }
 
+namespace {
+
+struct DetectNeedForUpdateData {
+  DepsgraphNodeBuilder *builder;
+  bool needs_update;
+};
+
+}  // namespace
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +468,46 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
+  DetectNeedForUpdateData *data = static_cast<DetectNeedForUpdateData *>(cb_data->user_data);
+  if (data->builder->id_cow_pointer_needs_update(id)) {
+    data->needs_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
+}
 
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+static bool id_node_needs_cow_pointers_check(const IDNode *id_node)
+{
+  if (id_node->previously_visible_components_mask == 0) {
+    /* Newly added node/ID, no need to check it. */
+    return false;
+  }
+  if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
+    /* Node/ID with no copy-on-eval data, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
+    /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
+    return false;
+  }
+  if ((id_node->id_cow->flag & ID_FLAG_EMBEDDED_DATA) != 0) {
+    /* For now, we assume embedded data are managed by their owner IDs and do not need to be
+     * checked here.
+     *
+     * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
+     * embedded data are handled as full local (private) data of their owner IDs in part of
+     * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
+     * as regular independent IDs. This leads to inconsistencies that can lead to bad level
+     * memory accesses.
+     *
+     * E.g. when undoing creation/deletion of a collection directly child of a scene's master
+     * collection, the scene itself is re-read in place, but its master collection becomes a
+     * completely new different pointer, and the existing copy-on-eval of the old master
+     * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
+     */
+    return false;
+  }
+  return true;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -493,41 +522,32 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
-    if (id_node->previously_visible_components_mask == 0) {
-      /* Newly added node/ID, no need to check it. */
-      continue;
-    }
-    if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
-      /* Node/ID with no copy-on-eval data, no need to check it. */
-      continue;
-    }
-    if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
-      /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
-      continue;
+  /* The ID nodes are checked in parallel, as walking over the ID pointers of every evaluated ID is
+   * costly in big scenes. Tagging modifies the graph, so it is done afterwards, in the order of the
+   * ID nodes. */
+  const Span<IDNode *> id_nodes = graph_->id_nodes;
+  Array<bool> id_nodes_need_update(id_nodes.size(), false);
+  threading::parallel_for(id_nodes.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const IDNode *id_node = id_nodes[i];
+      if (!id_node_needs_cow_pointers_check(id_node)) {
+        continue;
+      }
+      DetectNeedForUpdateData data = {this, false};
+      BKE_library_foreach_ID_link(nullptr,
+                                  id_node->id_cow,
+                                  deg::foreach_id_cow_detect_need_for_update_callback,
+                                  &data,
+                                  IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+      id_nodes_need_update[i] = data.needs_update;
     }
-    if ((id_node->id_cow->flag & ID_FLAG_EMBEDDED_DATA) != 0) {
-      /* For now, we assume embedded data are managed by their owner IDs and do not need to be
-       * checked here.
-       *
-       * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
-       * embedded data are handled as full local (private) data of their owner IDs in part of
-       * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
-       * as regular independent IDs. This leads to inconsistencies that can lead to bad level
-       * memory accesses.
-       *
-       * E.g. when undoing creation/deletion of a collection directly child of a scene's master
-       * collection, the scene itself is re-read in place, but its master collection becomes a
-       * completely new different pointer, and the existing copy-on-eval of the old master
-       * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
-       */
-      continue;
+  });
+
+  for (const int64_t i : id_nodes.index_range()) {
+    if (id_nodes_need_update[i]) {
+      graph_id_tag_update(
+          bmain_, graph_, id_nodes[i]->id_orig, ID_RECALC_SYNC_TO_EVAL, DEG_UPDATE_SOURCE_RELATIONS);
     }
-    BKE_library_foreach_ID_link(nullptr,
-                                id_node->id_cow,
-                                deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
-                                IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
   }
 }
 
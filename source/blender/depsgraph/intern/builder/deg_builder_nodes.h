@@ -63,6 +63,17 @@ struct OperationKey;
 struct OperationNode;
 struct TimeSourceNode;
 
+/* Creates the nodes of the graph by recursively walking the IDs, on a single thread.
+ *
+ * Independent parts of the walk (like the objects of different collections) can't be built
+ * concurrently into separate node lists, since they are not independent in the builder:
+ * - An ID used from several places (a material, a node tree) gets a single ID node, which is
+ *   decided by #built_map_ when the walk first reaches it.
+ * - Building an ID also creates the ID nodes of the IDs it references (see #ensure_cow_id), and
+ *   the nodes are added directly to the ID map and the operations list of the graph.
+ * - The walk depends on state of the builder like #is_parent_collection_visible_.
+ * Only the passes over the built nodes run in parallel, see #deg_graph_build_finalize and
+ * #update_invalid_cow_pointers. */
 class DepsgraphNodeBuilder : public DepsgraphBuilder {
  public:
   DepsgraphNodeBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
@@ -90,10 +101,10 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void end_build();
 
   /**
-   * `id_cow_self` is the user of `id_pointer`,
-   * see also `LibraryIDLinkCallbackData` struct definition.
+   * Whether the evaluated ID using `id_pointer` needs to be flushed for its pointers to be
+   * remapped. Only reads the graph, so it can be called from multiple threads.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool id_cow_pointer_needs_update(ID *id_pointer);
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
@@ -19,6 +19,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_memory_utils.hh"
 #include "BLI_span.hh"
 #include "BLI_utildefines.h"
 
@@ -375,7 +376,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return add_new_relation_with_owner(timesrc, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -390,6 +391,45 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
   return nullptr;
 }
 
+static const IDNode *get_owner_id_node(const Node *node)
+{
+  switch (node->get_class()) {
+    case NodeClass::OPERATION:
+      return static_cast<const OperationNode *>(node)->owner->owner;
+    case NodeClass::COMPONENT:
+      return static_cast<const ComponentNode *>(node)->owner;
+    case NodeClass::GENERIC:
+      break;
+  }
+  if (node->type == NodeType::ID_REF) {
+    return static_cast<const IDNode *>(node);
+  }
+  return nullptr;
+}
+
+Relation *DepsgraphRelationBuilder::add_new_relation_with_owner(Node *node_from,
+                                                                Node *node_to,
+                                                                const char *description,
+                                                                int flags)
+{
+  /* Only relations leading to a node of the object being built belong to that object. Other
+   * relations (e.g. the ones inside of a texture or mesh used by the object) might be needed by
+   * other objects which don't build them again, so they must be kept when the relations of the
+   * object are updated. */
+  unsigned int owner_session_uid = 0;
+  const IDNode *id_node_to = get_owner_id_node(node_to);
+  if (relation_owner_session_uid_ != 0 && id_node_to != nullptr &&
+      id_node_to->id_orig_session_uid == relation_owner_session_uid_)
+  {
+    owner_session_uid = relation_owner_session_uid_;
+  }
+  else if (is_relations_update_) {
+    /* Relations without owner are kept by the update, don't add them twice. */
+    flags |= RELATION_CHECK_BEFORE_ADD;
+  }
+  return graph_->add_new_relation(node_from, node_to, description, flags, owner_session_uid);
+}
+
 void DepsgraphRelationBuilder::add_visibility_relation(ID *id_from, ID *id_to)
 {
   ComponentKey from_key(id_from, NodeType::VISIBILITY);
@@ -403,7 +443,15 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    if (is_relations_update_ && node_from->is_noop() &&
+        node_from->inlinks.is_empty() && !(node_from->flag & OperationFlag::DEPSOP_FLAG_PINNED))
+    {
+      /* No-op nodes without incoming relations were removed when the graph was built, see
+       * #deg_graph_remove_unused_noops. */
+      failed_relations_num_++;
+      return nullptr;
+    }
+    return add_new_relation_with_owner(node_from, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -517,6 +565,31 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+bool DepsgraphRelationBuilder::build_object_relations_update(Span<Object *> objects)
+{
+  is_relations_update_ = true;
+  failed_relations_num_ = 0;
+  scene_ = graph_->scene;
+
+  /* Only relations leading to the nodes of the updated objects were removed, see
+   * #add_new_relation_with_owner. The relations of all other IDs in the graph are kept, so don't
+   * build them again when they are referenced by the updated objects. IDs which are newly
+   * referenced have no nodes yet, which makes the update fail. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (GS(id_node->id_orig->name) == ID_OB && objects.contains((Object *)id_node->id_orig)) {
+      continue;
+    }
+    built_map_.tagBuild(id_node->id_orig);
+  }
+
+  for (Object *object : objects) {
+    build_object(object);
+  }
+
+  is_relations_update_ = false;
+  return failed_relations_num_ == 0;
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -721,6 +794,10 @@ void DepsgraphRelationBuilder::build_object(Object *object)
 
   const BuilderStack::ScopedEntry stack_entry = stack_.trace(object->id);
 
+  const unsigned int prev_relation_owner_session_uid = relation_owner_session_uid_;
+  relation_owner_session_uid_ = object->id.session_uid;
+  BLI_SCOPED_DEFER([&]() { relation_owner_session_uid_ = prev_relation_owner_session_uid; });
+
   /* Object Transforms. */
   OperationCode base_op = (object->parent) ? OperationCode::TRANSFORM_PARENT :
                                              OperationCode::TRANSFORM_LOCAL;
@@ -1656,7 +1733,7 @@ void DepsgraphRelationBuilder::build_animdata_fcurve_target(
     add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     return;
   }
-  graph_->add_new_relation(
+  add_operation_relation(
       operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
   /* It is possible that animation is writing to a nested ID data-block,
    * need to make sure animation is evaluated after target ID is copied. */
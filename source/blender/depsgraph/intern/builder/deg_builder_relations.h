@@ -87,6 +87,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   void begin_build();
 
+  /* Re-build relations of the given objects in an already built graph, of which the relations
+   * owned by these objects were removed. Returns false when some relation could not be added,
+   * for example because the node it depends on does not exist in the graph: the whole graph is
+   * to be rebuilt then. */
+  bool build_object_relations_update(Span<Object *> objects);
+
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
                          const KeyTo &key_to,
@@ -310,6 +316,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                    const char *description,
                                    int flags = 0);
 
+  /* Add relation, owned by the object being built when it leads to one of its nodes. */
+  Relation *add_new_relation_with_owner(Node *node_from,
+                                        Node *node_to,
+                                        const char *description,
+                                        int flags);
+
   template<typename KeyType>
   DepsNodeHandle create_node_handle(const KeyType &key, const char *default_name = "");
 
@@ -346,6 +358,13 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
   BuilderStack stack_;
+
+  /* Session UID of the object whose relations are being built, stored in the added relations
+   * which lead to its own nodes. */
+  unsigned int relation_owner_session_uid_ = 0;
+  /* Relations are added to an already built graph, see #build_object_relations_update. */
+  bool is_relations_update_ = false;
+  int failed_relations_num_ = 0;
 };
 
 struct DepsNodeHandle {
@@ -40,6 +40,12 @@ Relation *DepsgraphRelationBuilder::add_relation(const KeyFrom &key_from,
     return add_operation_relation(op_from, op_to, description, flags);
   }
 
+  if (is_relations_update_) {
+    /* Nodes are not re-built for an update of the relations, fall back to a full rebuild. */
+    failed_relations_num_++;
+    return nullptr;
+  }
+
   /* TODO(sergey): Report error in the interface. */
 
   std::cerr << "--------------------------------------------------------------------\n";
@@ -89,6 +95,9 @@ Relation *DepsgraphRelationBuilder::add_node_handle_relation(const KeyType &key_
   if (op_from != nullptr && op_to != nullptr) {
     return add_operation_relation(op_from, op_to, description, flags);
   }
+  else if (is_relations_update_) {
+    failed_relations_num_++;
+  }
   else {
     if (!op_from) {
       fprintf(stderr,
@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/builder/deg_builder_relations_update.h"
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_global.hh"
+
+#include "DNA_object_types.h"
+
+#include "intern/builder/deg_builder_cache.h"
+#include "intern/builder/deg_builder_cycle.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/debug/deg_debug.h"
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/depsgraph_tag.hh"
+#include "intern/depsgraph_update.hh"
+#include "intern/eval/deg_eval_visibility.h"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+namespace {
+
+struct IDNodeEvalState {
+  uint32_t eval_flags;
+  DEGCustomDataMeshMasks customdata_masks;
+};
+
+void remove_owned_relations(Depsgraph *graph, const Set<unsigned int> &owner_session_uids)
+{
+  Vector<Relation *> relations_to_remove;
+  for (OperationNode *op_node : graph->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      /* Cycles are detected again for the whole graph. */
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+      if (rel->owner_session_uid != 0 && owner_session_uids.contains(rel->owner_session_uid)) {
+        relations_to_remove.append(rel);
+      }
+    }
+  }
+  for (Relation *rel : relations_to_remove) {
+    rel->unlink();
+    delete rel;
+  }
+}
+
+}  // namespace
+
+bool deg_graph_relations_update_incremental(Main *bmain, Depsgraph *graph)
+{
+  if (graph->update_relations_ids.is_empty()) {
+    return false;
+  }
+  /* Transitive reduction removed relations which might be needed once others are removed. */
+  if (G.debug_value == 799) {
+    return false;
+  }
+
+  Vector<Object *> objects;
+  Set<unsigned int> owner_session_uids;
+  for (ID *id : graph->update_relations_ids) {
+    if (GS(id->name) != ID_OB || graph->find_id_node(id) == nullptr) {
+      return false;
+    }
+    objects.append(reinterpret_cast<Object *>(id));
+    owner_session_uids.add(id->session_uid);
+  }
+
+  remove_owned_relations(graph, owner_session_uids);
+
+  Map<IDNode *, IDNodeEvalState> previous_eval_states;
+  for (IDNode *id_node : graph->id_nodes) {
+    previous_eval_states.add(id_node, {id_node->eval_flags, id_node->customdata_masks});
+  }
+
+  DepsgraphBuilderCache builder_cache;
+  DepsgraphRelationBuilder relation_builder(bmain, graph, &builder_cache);
+  if (!relation_builder.build_object_relations_update(objects)) {
+    DEG_DEBUG_PRINTF(reinterpret_cast<::Depsgraph *>(graph),
+                     BUILD,
+                     "Incremental relations update failed, rebuilding the graph\n");
+    return false;
+  }
+
+  deg_graph_detect_cycles(graph);
+  deg_graph_flush_visibility_flags(graph);
+
+  /* Same as when the graph is built, dependencies might have been added or removed. */
+  for (Object *object : objects) {
+    graph_id_tag_update(bmain,
+                        graph,
+                        &object->id,
+                        ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY,
+                        DEG_UPDATE_SOURCE_RELATIONS);
+  }
+  for (IDNode *id_node : graph->id_nodes) {
+    const IDNodeEvalState &previous_state = previous_eval_states.lookup(id_node);
+    int flag = 0;
+    if (id_node->eval_flags != previous_state.eval_flags) {
+      flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
+    }
+    if (id_node->customdata_masks != previous_state.customdata_masks) {
+      flag |= ID_RECALC_GEOMETRY;
+    }
+    if (flag != 0) {
+      graph_id_tag_update(bmain, graph, id_node->id_orig, flag, DEG_UPDATE_SOURCE_RELATIONS);
+    }
+  }
+
+  graph->update_relations_ids.clear();
+  graph->need_update_relations = false;
+  return true;
+}
+
+}  // namespace blender::deg
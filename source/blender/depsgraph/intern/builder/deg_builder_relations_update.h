@@ -0,0 +1,25 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+struct Main;
+
+namespace blender::deg {
+
+struct Depsgraph;
+
+/* Update relations of the objects in #Depsgraph.update_relations_ids without rebuilding the whole
+ * graph: relations owned by those objects are removed and built again, nodes are kept as-is.
+ *
+ * Returns false when the graph is to be fully rebuilt instead, for example when the relations
+ * refer to nodes which do not exist in the graph yet. The graph is not usable then until it is
+ * rebuilt. */
+bool deg_graph_relations_update_incremental(Main *bmain, Depsgraph *graph);
+
+}  // namespace blender::deg
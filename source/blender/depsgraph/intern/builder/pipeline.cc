@@ -92,6 +92,7 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->update_relations_ids.clear();
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
@@ -0,0 +1,230 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_string_ref.hh"
+#include "BLI_threads.h"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_type.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+namespace {
+
+struct TraceEvent {
+  string name;
+  const char *category;
+  string id_name;
+  string operation;
+  string depsgraph_name;
+  double start_time;
+  double end_time;
+};
+
+/* Events are stored per thread, to avoid any synchronization when recording them. */
+struct TraceThreadEvents {
+  int thread_index;
+  bool is_main_thread;
+  Vector<TraceEvent> events;
+};
+
+struct TraceState {
+  std::mutex mutex;
+  string filepath;
+  double start_time = 0.0;
+  /* Never freed while Blender runs, as the threads keep a pointer to their events. */
+  Vector<std::unique_ptr<TraceThreadEvents>> threads;
+};
+
+std::atomic<bool> trace_enabled = false;
+
+TraceState &trace_state()
+{
+  static TraceState state;
+  return state;
+}
+
+TraceThreadEvents &trace_thread_events()
+{
+  static thread_local TraceThreadEvents *thread_events = nullptr;
+  if (thread_events == nullptr) {
+    TraceState &state = trace_state();
+    std::lock_guard lock(state.mutex);
+    std::unique_ptr<TraceThreadEvents> new_events = std::make_unique<TraceThreadEvents>();
+    new_events->thread_index = int(state.threads.size());
+    new_events->is_main_thread = BLI_thread_is_main();
+    thread_events = new_events.get();
+    state.threads.append(std::move(new_events));
+  }
+  return *thread_events;
+}
+
+void trace_record(TraceEvent &&event)
+{
+  trace_thread_events().events.append(std::move(event));
+}
+
+void json_write_string(FILE *file, const StringRef str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        fputs("\\\"", file);
+        break;
+      case '\\':
+        fputs("\\\\", file);
+        break;
+      case '\n':
+        fputs("\\n", file);
+        break;
+      default:
+        if (uchar(c) < 0x20) {
+          fprintf(file, "\\u%04x", uint(uchar(c)));
+        }
+        else {
+          fputc(c, file);
+        }
+        break;
+    }
+  }
+  fputc('"', file);
+}
+
+void trace_write_event(FILE *file,
+                       const TraceState &state,
+                       const TraceThreadEvents &thread_events,
+                       const TraceEvent &event)
+{
+  /* Complete events ("X"), with timestamps in microseconds. */
+  fputs(",\n{\"ph\":\"X\",\"pid\":1,\"tid\":", file);
+  fprintf(file,
+          "%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+          thread_events.thread_index,
+          (event.start_time - state.start_time) * 1e6,
+          (event.end_time - event.start_time) * 1e6);
+  json_write_string(file, event.name);
+  fputs(",\"cat\":", file);
+  json_write_string(file, event.category);
+  fputs(",\"args\":{\"id\":", file);
+  json_write_string(file, event.id_name);
+  fputs(",\"operation\":", file);
+  json_write_string(file, event.operation);
+  fputs(",\"depsgraph\":", file);
+  json_write_string(file, event.depsgraph_name);
+  fputs("}}", file);
+}
+
+bool trace_write(const TraceState &state)
+{
+  FILE *file = BLI_fopen(state.filepath.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+  fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+  fputs("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"Blender\"}}",
+        file);
+  for (const std::unique_ptr<TraceThreadEvents> &thread_events : state.threads) {
+    fprintf(file,
+            ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":"
+            "\"%s %d\"}}",
+            thread_events->thread_index,
+            thread_events->is_main_thread ? "Main Thread" : "Thread",
+            thread_events->thread_index);
+    for (const TraceEvent &event : thread_events->events) {
+      trace_write_event(file, state, *thread_events, event);
+    }
+  }
+  fputs("\n]}\n", file);
+  return fclose(file) == 0;
+}
+
+}  // namespace
+
+void deg_debug_trace_begin(const char *filepath)
+{
+  TraceState &state = trace_state();
+  std::lock_guard lock(state.mutex);
+  state.filepath = filepath;
+  state.start_time = BLI_time_now_seconds();
+  for (std::unique_ptr<TraceThreadEvents> &thread_events : state.threads) {
+    thread_events->events.clear();
+  }
+  trace_enabled = true;
+}
+
+void deg_debug_trace_end()
+{
+  if (!trace_enabled) {
+    return;
+  }
+  trace_enabled = false;
+
+  TraceState &state = trace_state();
+  std::lock_guard lock(state.mutex);
+  if (trace_write(state)) {
+    printf("Depsgraph trace written to '%s'\n", state.filepath.c_str());
+  }
+  else {
+    fprintf(stderr, "Failed to write depsgraph trace to '%s'\n", state.filepath.c_str());
+  }
+  for (std::unique_ptr<TraceThreadEvents> &thread_events : state.threads) {
+    thread_events->events.clear_and_shrink();
+  }
+}
+
+bool deg_debug_trace_is_enabled()
+{
+  return trace_enabled.load(std::memory_order_relaxed);
+}
+
+void deg_debug_trace_record_operation(const Depsgraph *graph,
+                                      const OperationNode *operation_node,
+                                      const double start_time,
+                                      const double end_time)
+{
+  const ComponentNode *component_node = operation_node->owner;
+  TraceEvent event;
+  event.name = operation_node->full_identifier();
+  event.category = nodeTypeAsString(component_node->type);
+  event.id_name = component_node->owner->name;
+  event.operation = operationCodeAsString(operation_node->opcode);
+  event.depsgraph_name = graph->debug.name;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  trace_record(std::move(event));
+}
+
+void deg_debug_trace_record_evaluation(const Depsgraph *graph,
+                                       const double start_time,
+                                       const double end_time)
+{
+  TraceEvent event;
+  event.name = graph->debug.name.empty() ? "Depsgraph Evaluation" :
+                                           "Depsgraph Evaluation [" + graph->debug.name + "]";
+  event.category = "Depsgraph";
+  event.depsgraph_name = graph->debug.name;
+  event.start_time = start_time;
+  event.end_time = end_time;
+  trace_record(std::move(event));
+}
+
+}  // namespace blender::deg
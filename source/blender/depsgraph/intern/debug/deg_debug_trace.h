@@ -0,0 +1,37 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording of the evaluation of operations, written as a Chrome trace-event JSON file.
+ * See #DEG_debug_trace_begin.
+ */
+
+#pragma once
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct OperationNode;
+
+void deg_debug_trace_begin(const char *filepath);
+void deg_debug_trace_end();
+
+/* Cheap check whether a trace is being recorded, so that callers only gather timings when
+ * needed. */
+bool deg_debug_trace_is_enabled();
+
+/* Record evaluation of the operation, times are in seconds as returned by
+ * #BLI_time_now_seconds. Safe to call from multiple threads. */
+void deg_debug_trace_record_operation(const Depsgraph *graph,
+                                      const OperationNode *operation_node,
+                                      double start_time,
+                                      double end_time);
+/* Record evaluation of the whole graph. */
+void deg_debug_trace_record_evaluation(const Depsgraph *graph,
+                                       double start_time,
+                                       double end_time);
+
+}  // namespace blender::deg
@@ -174,7 +174,11 @@ void Depsgraph::clear_id_nodes()
   light_linking_cache.clear();
 }
 
-Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
+Relation *Depsgraph::add_new_relation(Node *from,
+                                      Node *to,
+                                      const char *description,
+                                      int flags,
+                                      const unsigned int owner_session_uid)
 {
   Relation *rel = nullptr;
   if (flags & RELATION_CHECK_BEFORE_ADD) {
@@ -182,6 +186,9 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   }
   if (rel != nullptr) {
     rel->flag |= flags;
+    if (rel->owner_session_uid != owner_session_uid) {
+      rel->owner_session_uid = 0;
+    }
     return rel;
   }
 
@@ -197,6 +204,7 @@ Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *descript
   /* Create new relation, and add it to the graph. */
   rel = new Relation(from, to, description);
   rel->flag |= flags;
+  rel->owner_session_uid = owner_session_uid;
   return rel;
 }
 
@@ -60,7 +60,13 @@ struct Depsgraph {
   void clear_id_nodes();
 
   /** Add new relationship between two nodes. */
-  Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
+  /* When \a owner_session_uid doesn't match the owner of an existing relation reused due to
+   * #RELATION_CHECK_BEFORE_ADD, the relation is considered to not have any owner anymore. */
+  Relation *add_new_relation(Node *from,
+                             Node *to,
+                             const char *description,
+                             int flags = 0,
+                             unsigned int owner_session_uid = 0);
 
   /* Check whether two nodes are connected by relation with given
    * description. Description might be nullptr to check ANY relation between
@@ -97,6 +103,9 @@ struct Depsgraph {
 
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
+  /* Objects of which only the relations need to be updated, see #DEG_id_relations_tag_update.
+   * Empty when the whole graph needs to be rebuilt. */
+  Set<ID *> update_relations_ids;
 
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
@@ -21,6 +21,7 @@
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_collection.hh"
 #include "BKE_main.hh"
@@ -31,6 +32,7 @@
 #include "DEG_depsgraph_debug.hh"
 
 #include "builder/deg_builder_relations.h"
+#include "builder/deg_builder_relations_update.h"
 #include "builder/pipeline_all_objects.h"
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_collection.h"
@@ -283,12 +285,8 @@ void DEG_graph_build_from_collection(Depsgraph *graph, Collection *collection)
   builder.build();
 }
 
-void DEG_graph_tag_relations_update(Depsgraph *graph)
+static void graph_tag_bases_update(deg::Depsgraph *deg_graph)
 {
-  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
-  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
-  deg_graph->need_update_relations = true;
-
   /* NOTE: When relations are updated, it's quite possible that we've got new bases in the scene.
    * This means, we need to re-create flat array of bases in view layer. */
   /* TODO(sergey): It is expected that bases manipulation tags scene for update to tag bases array
@@ -304,6 +302,17 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   }
 }
 
+void DEG_graph_tag_relations_update(Depsgraph *graph)
+{
+  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  deg_graph->need_update_relations = true;
+  /* The whole graph is rebuilt, no need to keep track of individual IDs. */
+  deg_graph->update_relations_ids.clear();
+
+  graph_tag_bases_update(deg_graph);
+}
+
 void DEG_graph_relations_update(Depsgraph *graph)
 {
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
@@ -311,6 +320,9 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (deg::deg_graph_relations_update_incremental(deg_graph->bmain, deg_graph)) {
+    return;
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
@@ -321,3 +333,27 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_depsgraph_incremental_relations) || GS(id->name) != ID_OB)
+  {
+    DEG_relations_tag_update(bmain);
+    return;
+  }
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *deg_graph : deg::get_all_registered_graphs(bmain)) {
+    if (deg_graph->need_update_relations && deg_graph->update_relations_ids.is_empty()) {
+      /* The whole graph is to be rebuilt already. */
+      continue;
+    }
+    if (deg_graph->find_id_node(id) == nullptr) {
+      /* Nodes of the object are to be built. */
+      DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(deg_graph));
+      continue;
+    }
+    deg_graph->need_update_relations = true;
+    deg_graph->update_relations_ids.add(id);
+    graph_tag_bases_update(deg_graph);
+  }
+}
@@ -20,9 +20,11 @@
 #include "DEG_depsgraph_query.hh"
 
 #include "intern/debug/deg_debug.h"
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_type.hh"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_id.hh"
 #include "intern/node/deg_node_time.hh"
@@ -53,6 +55,22 @@ const char *DEG_debug_name_get(Depsgraph *depsgraph)
   return deg_graph->debug.name.c_str();
 }
 
+void DEG_debug_print_evaluated_memory(const Depsgraph *graph, const int max_ids_num)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  deg::deg_eval_stats_print_memory(deg_graph, max_ids_num);
+}
+
+void DEG_debug_trace_begin(const char *filepath)
+{
+  deg::deg_debug_trace_begin(filepath);
+}
+
+void DEG_debug_trace_end()
+{
+  deg::deg_debug_trace_end();
+}
+
 bool DEG_debug_compare(const Depsgraph *graph1, const Depsgraph *graph2)
 {
   BLI_assert(graph1 != nullptr);
@@ -32,6 +32,7 @@
 
 #include "intern/depsgraph.hh"
 #include "intern/eval/deg_eval_copy_on_write.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_id.hh"
 
@@ -184,6 +185,16 @@ void DEG_get_customdata_mask_for_object(const Depsgraph *graph,
   r_mask->pmask |= id_node->customdata_masks.poly_mask;
 }
 
+int64_t DEG_get_evaluated_memory_for_id(const Depsgraph *graph, const ID *id)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  const deg::IDNode *id_node = deg_graph->find_id_node(deg::get_original_id(id));
+  if (id_node == nullptr) {
+    return 0;
+  }
+  return deg::deg_eval_stats_count_memory(id_node);
+}
+
 Scene *DEG_get_evaluated_scene(const Depsgraph *graph)
 {
   const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
@@ -48,6 +48,12 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* Session UID of the object whose relations were being built when this relation was added, if
+   * the relation leads to a node of that object. Otherwise MAIN_ID_SESSION_UID_UNSET. Allows to
+   * update the relations of an object without rebuilding the whole graph, see
+   * #deg_graph_relations_update_incremental. */
+  unsigned int owner_session_uid;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
@@ -723,6 +723,8 @@ void graph_id_tag_update(
    * Allows to have more granularity than a node-factory based flags. */
   if (id_node != nullptr) {
     id_node->id_cow->recalc |= flags;
+    /* Tagging without flags means anything could have changed. */
+    id_node->tagged_recalc_flags |= (flags != 0) ? flags : ID_RECALC_ALL;
   }
   /* When ID is tagged for update based on an user edits store the recalc flags in the original ID.
    * This way IDs in the undo steps will have this flag preserved, making it possible to restore
@@ -964,6 +966,7 @@ void DEG_ids_clear_recalc(Depsgraph *depsgraph, const bool backup)
      * the recalc flag. */
     id_node->is_user_modified = false;
     id_node->is_cow_explicitly_tagged = false;
+    id_node->tagged_recalc_flags = 0;
     deg_graph_clear_id_recalc_flags(id_node->id_cow);
     if (deg_graph->is_active) {
       deg_graph_clear_id_recalc_flags(id_node->id_orig);
@@ -10,6 +10,9 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <mutex>
+#include <queue>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
@@ -32,6 +35,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_tag.hh"
@@ -77,12 +81,46 @@ enum class EvaluationStage {
   SINGLE_THREADED_WORKAROUND,
 };
 
+/* Operations which are ready to be evaluated by the threaded stages, ordered so that the
+ * operations with the longest chain of dependent operations (#OperationNode.critical_path_time)
+ * are evaluated first. Otherwise a long chain like rig, deformation and subdivision might only
+ * start once the threads are done with a lot of cheap operations, delaying the whole update. */
+class ReadyOperationQueue {
+  struct Compare {
+    bool operator()(const OperationNode *a, const OperationNode *b) const
+    {
+      return a->critical_path_time < b->critical_path_time;
+    }
+  };
+
+  std::mutex mutex_;
+  std::priority_queue<OperationNode *, std::vector<OperationNode *>, Compare> queue_;
+
+ public:
+  void push(OperationNode *node)
+  {
+    std::lock_guard lock(mutex_);
+    queue_.push(node);
+  }
+
+  OperationNode *pop()
+  {
+    std::lock_guard lock(mutex_);
+    BLI_assert(!queue_.empty());
+    OperationNode *node = queue_.top();
+    queue_.pop();
+    return node;
+  }
+};
+
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  bool do_trace;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+  ReadyOperationQueue ready_queue;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -91,14 +129,17 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation, always timing it to keep the estimates used for scheduling up to date. */
+  const double start_time = BLI_time_now_seconds();
+  operation_node->evaluate(depsgraph);
+  const double end_time = BLI_time_now_seconds();
+  const double time = end_time - start_time;
+  operation_node->stats.update_estimated_time(time);
   if (state->do_stats) {
-    const double start_time = BLI_time_now_seconds();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    operation_node->stats.current_time += time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (state->do_trace) {
+    deg_debug_trace_record_operation(state->graph, operation_node, start_time, end_time);
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -108,18 +149,26 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
-void deg_task_run_func(TaskPool *pool, void *taskdata)
+/* Add an operation to the ready queue, along with a task which evaluates the most important
+ * operation of the queue (not necessarily this one). */
+void schedule_ready_node(DepsgraphEvalState *state, TaskPool *pool, OperationNode *node)
+{
+  state->ready_queue.push(node);
+  BLI_task_pool_push(pool, deg_task_run_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_func(TaskPool *pool, void * /*taskdata*/)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
+  /* Evaluate node. There is one task per operation pushed to the queue, so it is never empty. */
+  OperationNode *operation_node = state->ready_queue.pop();
   evaluate_node(state, operation_node);
 
   /* Schedule children. */
   schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    schedule_ready_node(state, pool, node);
   });
 }
 
@@ -194,6 +243,13 @@ void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
       node->stats.reset_current();
     }
   }
+
+  /* Prioritize the operations on the longest chains of operations to be evaluated, based on how
+   * long they took to evaluate during the previous updates. */
+  deg_eval_critical_path_calculate(
+      graph,
+      [](const OperationNode *node) { return node->stats.estimated_time; },
+      [](const OperationNode *node) { return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) != 0; });
 }
 
 bool is_metaball_object_operation(const OperationNode *operation_node)
@@ -317,9 +373,8 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  schedule_graph(state,
+                 [&](OperationNode *node) { schedule_ready_node(state, task_pool, node); });
   BLI_task_pool_work_and_wait(task_pool);
 }
 
@@ -402,9 +457,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.do_trace = deg_debug_trace_is_enabled();
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
+  const double evaluation_start_time = (state.do_stats || state.do_trace) ?
+                                           BLI_time_now_seconds() :
+                                           0.0;
 
   /* Evaluation happens in several incremental steps:
    *
@@ -455,6 +514,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
+    deg_eval_stats_print_parallelism(graph, BLI_time_now_seconds() - evaluation_start_time);
+  }
+  if (state.do_trace) {
+    deg_debug_trace_record_evaluation(graph, evaluation_start_time, BLI_time_now_seconds());
   }
 
   /* Clear any uncleared tags. */
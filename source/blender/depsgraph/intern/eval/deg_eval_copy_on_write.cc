@@ -761,11 +761,129 @@ int foreach_libblock_validate_callback(LibraryIDLinkCallbackData *cb_data)
   return IDWALK_RET_NOP;
 }
 
+/* Data of a previous evaluated copy which is known to be unchanged in the original ID, and which
+ * is moved to the new evaluated copy instead of being copied again. */
+struct EvalCopyReusedData {
+  bPose *pose = nullptr;
+  ListBase modifiers = {nullptr, nullptr};
+
+  bool is_empty() const
+  {
+    return pose == nullptr && BLI_listbase_is_empty(&modifiers);
+  }
+};
+
+/* Recalc flags which don't affect the pose and modifiers of an object: changes of those are
+ * always tagged with #ID_RECALC_GEOMETRY (or explicit copy-on-evaluation). */
+constexpr uint32_t OBJECT_REUSE_EVAL_DATA_RECALC_MASK = ID_RECALC_TRANSFORM | ID_RECALC_SELECT |
+                                                       ID_RECALC_BASE_FLAGS;
+
+bool object_can_reuse_eval_data(const IDNode *id_node)
+{
+  const uint32_t tagged_recalc_flags = id_node->tagged_recalc_flags;
+  if (tagged_recalc_flags == 0 || (tagged_recalc_flags & ~OBJECT_REUSE_EVAL_DATA_RECALC_MASK)) {
+    return false;
+  }
+  return !id_node->is_cow_explicitly_tagged && check_datablock_expanded(id_node->id_cow);
+}
+
+/* Pose channels are only reused when they still match the original pose, which is not the case
+ * when bones were added or removed. */
+bool object_pose_is_reusable(const Object *object_orig, const Object *object_cow)
+{
+  if (object_orig->type != OB_ARMATURE || object_orig->pose == nullptr ||
+      object_cow->pose == nullptr)
+  {
+    return false;
+  }
+  if (object_orig->pose->flag & POSE_RECALC) {
+    return false;
+  }
+  if (((const bArmature *)object_orig->data)->edbo != nullptr) {
+    return false;
+  }
+  const bPoseChannel *pchan_cow = (const bPoseChannel *)object_cow->pose->chanbase.first;
+  LISTBASE_FOREACH (const bPoseChannel *, pchan_orig, &object_orig->pose->chanbase) {
+    if (pchan_cow == nullptr || !STREQ(pchan_orig->name, pchan_cow->name)) {
+      return false;
+    }
+    pchan_cow = pchan_cow->next;
+  }
+  return pchan_cow == nullptr;
+}
+
+bool object_modifiers_are_reusable(const Object *object_orig, const Object *object_cow)
+{
+  /* Particle system modifiers point to particle systems of the object, which are copied. */
+  if (!BLI_listbase_is_empty(&object_orig->particlesystem) ||
+      BLI_listbase_is_empty(&object_orig->modifiers))
+  {
+    return false;
+  }
+  const ModifierData *md_cow = (const ModifierData *)object_cow->modifiers.first;
+  LISTBASE_FOREACH (const ModifierData *, md_orig, &object_orig->modifiers) {
+    if (md_cow == nullptr || md_orig->type != md_cow->type ||
+        md_orig->persistent_uid != md_cow->persistent_uid)
+    {
+      return false;
+    }
+    md_cow = md_cow->next;
+  }
+  return md_cow == nullptr;
+}
+
+/* Detach data of the evaluated object which can be kept when updating its copy, so that it's not
+ * freed nor backed up. */
+void object_detach_reusable_eval_data(const IDNode *id_node, EvalCopyReusedData *r_reused_data)
+{
+  if (!object_can_reuse_eval_data(id_node)) {
+    return;
+  }
+  const Object *object_orig = (const Object *)id_node->id_orig;
+  Object *object_cow = (Object *)id_node->id_cow;
+  if (object_pose_is_reusable(object_orig, object_cow)) {
+    r_reused_data->pose = object_cow->pose;
+    object_cow->pose = nullptr;
+  }
+  if (object_modifiers_are_reusable(object_orig, object_cow)) {
+    r_reused_data->modifiers = object_cow->modifiers;
+    BLI_listbase_clear(&object_cow->modifiers);
+  }
+}
+
+/* Copy the original object without the data which is reused from the previous evaluated copy. */
+bool object_copy_inplace_no_main_reuse(const Object *object,
+                                       Object *new_object,
+                                       const EvalCopyReusedData &reused_data)
+{
+  Object object_for_copy = dna::shallow_copy(*object);
+  if (reused_data.pose != nullptr) {
+    object_for_copy.pose = nullptr;
+  }
+  if (!BLI_listbase_is_empty(&reused_data.modifiers)) {
+    BLI_listbase_clear(&object_for_copy.modifiers);
+  }
+  if (!id_copy_inplace_no_main(&object_for_copy.id, &new_object->id)) {
+    return false;
+  }
+  /* The ID pointers of the reused data already point to evaluated IDs, remapping them is a no-op.
+   * Bone pointers and original pointers of the pose are updated in #update_id_after_copy. */
+  if (reused_data.pose != nullptr) {
+    new_object->pose = reused_data.pose;
+  }
+  if (!BLI_listbase_is_empty(&reused_data.modifiers)) {
+    new_object->modifiers = reused_data.modifiers;
+  }
+  return true;
+}
+
 /* Actual implementation of logic which "expands" all the data which was not
  * yet copied-on-eval.
  *
  * NOTE: Expects that evaluated datablock is empty. */
-ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
+ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph,
+                                   const IDNode *id_node,
+                                   const EvalCopyReusedData *reused_data = nullptr)
 {
   const ID *id_orig = id_node->id_orig;
   ID *id_cow = id_node->id_cow;
@@ -809,9 +927,16 @@ ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
       }
       break;
     }
+    case ID_OB: {
+      if (reused_data != nullptr && !reused_data->is_empty()) {
+        done = object_copy_inplace_no_main_reuse(
+            (const Object *)id_orig, (Object *)id_cow, *reused_data);
+      }
+      break;
+    }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* NOTE: Geometry arrays are implicitly shared with the original mesh, so they are not
+       * actually copied here. */
       break;
     }
     default:
@@ -898,10 +1023,17 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
     }
   }
 
+  /* Keep unchanged data of the evaluated object, like the pose which can be expensive to copy for
+   * big rigs, when only its transform changed. The reused data keeps its runtime data as well. */
+  EvalCopyReusedData reused_data;
+  if (GS(id_orig->name) == ID_OB) {
+    object_detach_reusable_eval_data(id_node, &reused_data);
+  }
+
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_eval_copy_datablock(id_cow);
-  deg_expand_eval_copy_datablock(depsgraph, id_node);
+  deg_expand_eval_copy_datablock(depsgraph, id_node, &reused_data);
   backup.restore_to_id(id_cow);
   return id_cow;
 }
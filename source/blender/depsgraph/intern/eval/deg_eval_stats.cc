@@ -8,9 +8,34 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <algorithm>
+#include <cstdio>
+
+#include "BLI_array.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BKE_curves.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_grease_pencil.hh"
+#include "BKE_mesh.hh"
+#include "BKE_object_types.hh"
+#include "BKE_pointcloud.hh"
+#include "BKE_volume.hh"
+
+#include "DNA_curves_types.h"
+#include "DNA_grease_pencil_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_volume_types.h"
 
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/eval/deg_eval_copy_on_write.h"
 
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -39,4 +64,200 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+double deg_eval_critical_path_calculate(
+    Depsgraph *graph,
+    const FunctionRef<double(const OperationNode *node)> time_fn,
+    const FunctionRef<bool(const OperationNode *node)> is_evaluated_fn)
+{
+  /* Depth-first traversal along the relations, calculating the time of an operation once the
+   * times of all its children are known. Uses an explicit stack since chains of operations can
+   * be very long in big rigs.
+   *
+   * custom_flags: 0 when not visited yet, 1 while on the stack, 2 once calculated. */
+  enum { NOT_VISITED = 0, VISITING = 1, DONE = 2 };
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = NOT_VISITED;
+    node->critical_path_time = 0.0;
+  }
+
+  auto is_followed_relation = [&](const Relation *rel) {
+    if (rel->flag & RELATION_FLAG_CYCLIC) {
+      return false;
+    }
+    BLI_assert(rel->to->type == NodeType::OPERATION);
+    return is_evaluated_fn(static_cast<const OperationNode *>(rel->to));
+  };
+
+  double longest_time = 0.0;
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags != NOT_VISITED || !is_evaluated_fn(root)) {
+      continue;
+    }
+    root->custom_flags = VISITING;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      OperationNode *node = stack.last().first;
+      int64_t &child_index = stack.last().second;
+      if (child_index < node->outlinks.size()) {
+        Relation *rel = node->outlinks[child_index++];
+        OperationNode *child = static_cast<OperationNode *>(rel->to);
+        if (child->custom_flags == NOT_VISITED && is_followed_relation(rel)) {
+          child->custom_flags = VISITING;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      /* All children are calculated, unless there is a dependency cycle which is not tagged as
+       * such, in which case the child on the stack is ignored. */
+      double children_time = 0.0;
+      for (Relation *rel : node->outlinks) {
+        if (is_followed_relation(rel)) {
+          children_time = std::max(children_time,
+                                    static_cast<OperationNode *>(rel->to)->critical_path_time);
+        }
+      }
+      node->critical_path_time = time_fn(node) + children_time;
+      node->custom_flags = DONE;
+      longest_time = std::max(longest_time, node->critical_path_time);
+      stack.remove_last();
+    }
+  }
+  return longest_time;
+}
+
+void deg_eval_stats_print_parallelism(Depsgraph *graph, const double evaluation_time)
+{
+  double work_time = 0.0;
+  for (OperationNode *op_node : graph->operations) {
+    work_time += op_node->stats.current_time;
+  }
+  const double critical_path_time = deg_eval_critical_path_calculate(
+      graph,
+      [](const OperationNode *node) { return node->stats.current_time; },
+      [](const OperationNode * /*node*/) { return true; });
+  if (work_time == 0.0 || evaluation_time == 0.0 || critical_path_time == 0.0) {
+    return;
+  }
+
+  const char *name = graph->debug.name.empty() ? "" : graph->debug.name.c_str();
+  printf("Depsgraph%s%s%s parallelism: %.2fx achieved, %.2fx ideal (%f seconds of work, %f "
+         "seconds on the critical path).\n",
+         name[0] ? " [" : "",
+         name,
+         name[0] ? "]" : "",
+         work_time / evaluation_time,
+         work_time / critical_path_time,
+         work_time,
+         critical_path_time);
+}
+
+static void count_evaluated_geometry_memory(const ID &id, MemoryCounter &memory)
+{
+  switch (GS(id.name)) {
+    case ID_ME:
+      reinterpret_cast<const Mesh &>(id).count_memory(memory);
+      break;
+    case ID_CV:
+      reinterpret_cast<const Curves &>(id).geometry.wrap().count_memory(memory);
+      break;
+    case ID_PT:
+      reinterpret_cast<const PointCloud &>(id).count_memory(memory);
+      break;
+    case ID_GP:
+      reinterpret_cast<const GreasePencil &>(id).count_memory(memory);
+      break;
+    case ID_VO:
+      BKE_volume_count_memory(reinterpret_cast<const Volume &>(id), memory);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * Data shared between the geometry set and the evaluated meshes, or between objects, is only
+ * counted once as long as the same counter is used for it.
+ */
+static void count_evaluated_object_memory(const Object &object, MemoryCounter &memory)
+{
+  const bke::ObjectRuntime &runtime = *object.runtime;
+  if (runtime.geometry_set_eval != nullptr) {
+    runtime.geometry_set_eval->count_memory(memory);
+  }
+  if (runtime.data_eval != nullptr) {
+    count_evaluated_geometry_memory(*runtime.data_eval, memory);
+  }
+  for (const Mesh *mesh : {runtime.mesh_deform_eval, runtime.editmesh_eval_cage}) {
+    if (mesh != nullptr && &mesh->id != runtime.data_eval) {
+      mesh->count_memory(memory);
+    }
+  }
+}
+
+static const Object *evaluated_object_with_memory(const IDNode *id_node)
+{
+  /* Only objects own evaluated data which is not shared with their original. */
+  if (id_node->id_type != ID_OB || !deg_eval_copy_is_expanded(id_node->id_cow)) {
+    return nullptr;
+  }
+  return reinterpret_cast<const Object *>(id_node->id_cow);
+}
+
+int64_t deg_eval_stats_count_memory(const IDNode *id_node)
+{
+  const Object *object = evaluated_object_with_memory(id_node);
+  if (object == nullptr) {
+    return 0;
+  }
+  MemoryCount count;
+  MemoryCounter memory{count};
+  count_evaluated_object_memory(*object, memory);
+  return count.total_bytes;
+}
+
+void deg_eval_stats_print_memory(const Depsgraph *graph, const int max_ids_num)
+{
+  Array<int64_t> bytes_by_node(graph->id_nodes.size());
+  threading::parallel_for(graph->id_nodes.index_range(), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      bytes_by_node[i] = deg_eval_stats_count_memory(graph->id_nodes[i]);
+    }
+  });
+
+  Vector<int> node_indices;
+  for (const int i : graph->id_nodes.index_range()) {
+    if (bytes_by_node[i] > 0) {
+      node_indices.append(i);
+    }
+  }
+  /* The per data-block counts are only used for the ranking. Data shared between objects is
+   * included in each of them, so the total is counted separately. */
+  MemoryCount total_count;
+  MemoryCounter total_memory{total_count};
+  for (const IDNode *id_node : graph->id_nodes) {
+    if (const Object *object = evaluated_object_with_memory(id_node)) {
+      count_evaluated_object_memory(*object, total_memory);
+    }
+  }
+  const int64_t total_bytes = total_count.total_bytes;
+  std::sort(node_indices.begin(), node_indices.end(), [&](const int a, const int b) {
+    return bytes_by_node[a] > bytes_by_node[b];
+  });
+
+  char size_str[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+  BLI_str_format_byte_unit(size_str, total_bytes, false);
+  const char *name = graph->debug.name.empty() ? "" : graph->debug.name.c_str();
+  printf("Depsgraph%s%s%s evaluated data memory: %s in %d data-blocks\n",
+         name[0] ? " [" : "",
+         name,
+         name[0] ? "]" : "",
+         size_str,
+         int(node_indices.size()));
+  for (const int i : node_indices.as_span().take_front(max_ids_num)) {
+    BLI_str_format_byte_unit(size_str, bytes_by_node[i], false);
+    printf("  %10s  %s\n", size_str, graph->id_nodes[i]->id_orig->name);
+  }
+}
+
 }  // namespace blender::deg
@@ -8,11 +8,38 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "BLI_function_ref.hh"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct IDNode;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Calculate #OperationNode.critical_path_time for all operations, using the given time for every
+ * operation. Only operations for which #is_evaluated_fn returns true are taken into account.
+ *
+ * Returns the time of the longest chain of operations in the graph. */
+double deg_eval_critical_path_calculate(
+    Depsgraph *graph,
+    FunctionRef<double(const OperationNode *node)> time_fn,
+    FunctionRef<bool(const OperationNode *node)> is_evaluated_fn);
+
+/* Print how well the last evaluation of the graph used the available parallelism: the achieved
+ * speedup compared to evaluating all operations serially, and the ideal speedup which is limited
+ * by the longest chain of dependent operations. Uses the timing of the current evaluation. */
+void deg_eval_stats_print_parallelism(Depsgraph *graph, double evaluation_time);
+
+/* Count the memory used by the evaluated data of the ID. Data shared with other IDs is counted
+ * for each of them. Only done on request, this is not needed for evaluation. */
+int64_t deg_eval_stats_count_memory(const IDNode *id_node);
+
+/* Print the total memory used by evaluated data, and the IDs using most of it. */
+void deg_eval_stats_print_memory(const Depsgraph *graph, int max_ids_num);
+
 }  // namespace blender::deg
@@ -274,6 +274,7 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  estimated_time = 0.0;
 }
 
 void Node::Stats::reset_current()
@@ -281,6 +282,18 @@ void Node::Stats::reset_current()
   current_time = 0.0;
 }
 
+void Node::Stats::update_estimated_time(const double time)
+{
+  /* Exponential moving average: follows changes in the evaluation cost within a few frames,
+   * while smoothing out the noise of individual measurements. */
+  if (estimated_time == 0.0) {
+    estimated_time = time;
+  }
+  else {
+    estimated_time += (time - estimated_time) * 0.25;
+  }
+}
+
 /*******************************************************************************
  * Node itself.
  */
@@ -166,8 +166,13 @@ struct Node {
     /* Reset counters needed for the current graph evaluation, does not
      * touch averaging accumulators. */
     void reset_current();
+    /* Accumulate the time of an evaluation of this node into the estimated time. */
+    void update_estimated_time(double time);
     /* Time spent on this node during current graph evaluation. */
     double current_time;
+    /* Evaluation time of this node, smoothed over the graph evaluations. Persists until the graph
+     * is rebuilt, and is used to schedule the operations on the critical path first. */
+    double estimated_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
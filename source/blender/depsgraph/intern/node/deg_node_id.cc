@@ -74,6 +74,7 @@ void IDNode::init(const ID *id, const char * /*subdata*/)
   has_base = false;
   is_user_modified = false;
   id_cow_recalc_backup = 0;
+  tagged_recalc_flags = ID_RECALC_ALL;
 
   visible_components_mask = 0;
   previously_visible_components_mask = 0;
@@ -121,6 +121,12 @@ struct IDNode : public Node {
   /* Copy-on-Write component has been explicitly tagged for update. */
   bool is_cow_explicitly_tagged;
 
+  /* Recalc flags the ID has been tagged with since its last evaluation, not including the flags
+   * accumulated when flushing updates. Allows to keep parts of the evaluated copy which could not
+   * have changed when updating it. All flags are set when the node is created, as changes done
+   * before the graph was built are not known. */
+  uint32_t tagged_recalc_flags;
+
   /* Accumulate recalc flags from multiple update passes. */
   int id_cow_recalc_backup;
 
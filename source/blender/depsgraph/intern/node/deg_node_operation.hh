@@ -282,6 +282,10 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated time of the longest chain of operations which are to be evaluated starting from
+   * this one, including this operation itself. See #deg_eval_critical_path_calculate. */
+  double critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -6,7 +6,6 @@
  * \ingroup edasset
  */
 
-#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <optional>
@@ -56,6 +55,8 @@ using namespace blender::bke::idprop;
  * \code
  * {
  *   "version": <file version number>,
+ *   "file_size": <size of the indexed file in bytes>,
+ *   "file_mtime": <modification time of the indexed file>,
  *   "entries": [{
  *     "name": "<asset name>",
  *     "catalog_id": "<catalog_id>",
@@ -73,11 +74,17 @@ using namespace blender::bke::idprop;
  * NOTE: entries, author, description, copyright, license, tags and properties are optional
  * attributes.
  *
+ * NOTE: The size and modification time of the indexed file are stored so that an index is only
+ * used when it matches the exact file it was created from. Only comparing modification times
+ * isn't enough, e.g. when a library file is replaced by an older version synced from elsewhere.
+ *
  * NOTE: File browser uses name and idcode separate. Inside the index they are joined together like
  * #ID.name.
  * NOTE: File browser group name isn't stored in the index as it is a translatable name.
  */
 constexpr StringRef ATTRIBUTE_VERSION("version");
+constexpr StringRef ATTRIBUTE_FILE_SIZE("file_size");
+constexpr StringRef ATTRIBUTE_FILE_MTIME("file_mtime");
 constexpr StringRef ATTRIBUTE_ENTRIES("entries");
 constexpr StringRef ATTRIBUTE_ENTRIES_NAME("name");
 constexpr StringRef ATTRIBUTE_ENTRIES_CATALOG_ID("catalog_id");
@@ -100,11 +107,6 @@ class AbstractFile {
   {
     return BLI_exists(this->get_file_path());
   }
-
-  size_t get_file_size() const
-  {
-    return BLI_file_size(this->get_file_path());
-  }
 };
 
 /**
@@ -133,6 +135,23 @@ class BlendFile : public AbstractFile {
   {
     return file_path_.c_str();
   }
+
+  /**
+   * Get the size and modification time of the file, used to identify the exact version of the
+   * file an index was created from.
+   *
+   * \return false when the file couldn't be accessed.
+   */
+  bool get_stat(int64_t &r_size, int64_t &r_mtime) const
+  {
+    BLI_stat_t stat = {};
+    if (BLI_stat(this->get_file_path(), &stat) == -1) {
+      return false;
+    }
+    r_size = int64_t(stat.st_size);
+    r_mtime = int64_t(stat.st_mtime);
+    return true;
+  }
 };
 
 /**
@@ -203,8 +222,7 @@ static void init_value_from_file_indexer_entries(DictionaryValue &result,
     init_value_from_file_indexer_entry(*entries->append_dict(), indexer_entry);
   }
 
-  /* When no entries to index, we should not store the entries attribute as this would make the
-   * size bigger than the #MIN_FILE_SIZE_WITH_ENTRIES. */
+  /* Don't store the entries attribute when there is nothing to index. */
   if (entries->elements().is_empty()) {
     return;
   }
@@ -400,13 +418,6 @@ struct AssetLibraryIndex {
     return false;
   }
 
-  /**
-   * A bug was creating empty index files for a while (see D16665). Remove empty index files from
-   * this period, so they are regenerated.
-   */
-  /* Implemented further below. */
-  int remove_broken_index_files();
-
   int remove_unused_index_files()
   {
     int num_files_deleted = 0;
@@ -451,7 +462,7 @@ struct AssetIndex {
    * `CURRENT_VERSION` to make sure we can use the index. Developer should increase
    * `CURRENT_VERSION` when changes are made to the structure of the stored index.
    */
-  static const int CURRENT_VERSION = 1;
+  static const int CURRENT_VERSION = 2;
 
   /**
    * Version number to use when version couldn't be read from an index file.
@@ -469,12 +480,17 @@ struct AssetIndex {
 
   /**
    * Constructor for when creating/updating an asset index file.
-   * #AssetIndex.contents are filled from the given \p indexer_entries.
+   * #AssetIndex.contents are filled from the given \p indexer_entries of \p asset_file.
    */
-  AssetIndex(const FileIndexerEntries &indexer_entries)
+  AssetIndex(const BlendFile &asset_file, const FileIndexerEntries &indexer_entries)
   {
     std::unique_ptr<DictionaryValue> root = std::make_unique<DictionaryValue>();
     root->append_int(ATTRIBUTE_VERSION, CURRENT_VERSION);
+    int64_t file_size, file_mtime;
+    if (asset_file.get_stat(file_size, file_mtime)) {
+      root->append_int(ATTRIBUTE_FILE_SIZE, file_size);
+      root->append_int(ATTRIBUTE_FILE_MTIME, file_mtime);
+    }
     init_value_from_file_indexer_entries(*root, indexer_entries);
 
     this->contents = std::move(root);
@@ -501,6 +517,34 @@ struct AssetIndex {
     return get_version() == CURRENT_VERSION;
   }
 
+  /**
+   * Check if this index was created from the current version of \p asset_file, by comparing the
+   * stored size and modification time with the ones of the file.
+   */
+  bool is_created_from(const BlendFile &asset_file) const
+  {
+    const DictionaryValue *root = this->contents->as_dictionary_value();
+    if (root == nullptr) {
+      return false;
+    }
+    const std::optional<int64_t> stored_size = root->lookup_int(ATTRIBUTE_FILE_SIZE);
+    const std::optional<int64_t> stored_mtime = root->lookup_int(ATTRIBUTE_FILE_MTIME);
+    if (!stored_size || !stored_mtime) {
+      return false;
+    }
+    int64_t file_size, file_mtime;
+    if (!asset_file.get_stat(file_size, file_mtime)) {
+      return false;
+    }
+    return *stored_size == file_size && *stored_mtime == file_mtime;
+  }
+
+  bool has_entries() const
+  {
+    const DictionaryValue *root = this->contents->as_dictionary_value();
+    return root != nullptr && root->lookup_array(ATTRIBUTE_ENTRIES) != nullptr;
+  }
+
   /**
    * Extract the contents of this index into the given \p indexer_entries.
    *
@@ -517,11 +561,6 @@ struct AssetIndex {
 class AssetIndexFile : public AbstractFile {
  public:
   AssetLibraryIndex &library_index;
-  /**
-   * Asset index files with a size smaller than this attribute would be considered to not contain
-   * any entries.
-   */
-  const size_t MIN_FILE_SIZE_WITH_ENTRIES = 32;
   std::string filename;
 
   AssetIndexFile(AssetLibraryIndex &library_index, StringRef index_file_path)
@@ -544,23 +583,6 @@ class AssetIndexFile : public AbstractFile {
     return filename.c_str();
   }
 
-  /**
-   * Returns whether the index file is older than the given asset file.
-   */
-  bool is_older_than(const BlendFile &asset_file) const
-  {
-    return BLI_file_older(this->get_file_path(), asset_file.get_file_path());
-  }
-
-  /**
-   * Check whether the index file contains entries without opening the file.
-   */
-  bool constains_entries() const
-  {
-    const size_t file_size = get_file_size();
-    return file_size >= MIN_FILE_SIZE_WITH_ENTRIES;
-  }
-
   std::unique_ptr<AssetIndex> read_contents() const
   {
     JsonFormatter formatter;
@@ -592,55 +614,6 @@ class AssetIndexFile : public AbstractFile {
   }
 };
 
-/* TODO(Julian): remove this after a short while. Just necessary for people who've been using alpha
- * builds from a certain period. */
-int AssetLibraryIndex::remove_broken_index_files()
-{
-  Set<StringRef> files_to_remove;
-
-  for (const std::string &index_path : this->preexisting_file_indices.keys()) {
-    AssetIndexFile index_file(*this, index_path);
-
-    /* Bug was causing empty index files, so non-empty ones can be skipped. */
-    if (index_file.constains_entries()) {
-      continue;
-    }
-
-    /* Use the file modification time stamp to attempt to remove empty index files from a
-     * certain period (when the bug was in there). Starting from a day before the bug was
-     * introduced until a day after the fix should be enough to mitigate possible local time
-     * zone issues. */
-
-    std::tm tm_from{};
-    tm_from.tm_year = 2022 - 1900; /* 2022 */
-    tm_from.tm_mon = 11 - 1;       /* November */
-    tm_from.tm_mday = 8;           /* Day before bug was introduced. */
-    std::tm tm_to{};
-    tm_from.tm_year = 2022 - 1900; /* 2022 */
-    tm_from.tm_mon = 12 - 1;       /* December */
-    tm_from.tm_mday = 3;           /* Day after fix. */
-    std::time_t timestamp_from = std::mktime(&tm_from);
-    std::time_t timestamp_to = std::mktime(&tm_to);
-    BLI_stat_t stat = {};
-    if (BLI_stat(index_file.get_file_path(), &stat) == -1) {
-      continue;
-    }
-    if (IN_RANGE(stat.st_mtime, timestamp_from, timestamp_to)) {
-      CLOG_INFO(&LOG, 2, "Remove potentially broken index file [%s].", index_path.c_str());
-      files_to_remove.add(index_path);
-    }
-  }
-
-  int num_files_deleted = 0;
-  for (StringRef filepath : files_to_remove) {
-    if (delete_file_index(filepath)) {
-      num_files_deleted++;
-    }
-  }
-
-  return num_files_deleted;
-}
-
 static eFileIndexerResult read_index(const char *filename,
                                      FileIndexerEntries *entries,
                                      int *r_read_entries_len,
@@ -660,34 +633,34 @@ static eFileIndexerResult read_index(const char *filename,
    */
   asset_index_file.mark_as_used();
 
-  if (asset_index_file.is_older_than(asset_file)) {
-    CLOG_INFO(
-        &LOG,
-        3,
-        "Asset index file [%s] needs to be refreshed as it is older than the asset file [%s].",
-        asset_index_file.filename.c_str(),
-        filename);
+  std::unique_ptr<AssetIndex> contents = asset_index_file.read_contents();
+  if (!contents->is_latest_version()) {
+    CLOG_INFO(&LOG,
+              3,
+              "Asset file index is ignored; expected version %d but file is version %d [%s].",
+              AssetIndex::CURRENT_VERSION,
+              contents->get_version(),
+              asset_index_file.filename.c_str());
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
-  if (!asset_index_file.constains_entries()) {
+  if (!contents->is_created_from(asset_file)) {
     CLOG_INFO(&LOG,
               3,
-              "Asset file index is to small to contain any entries. [%s]",
-              asset_index_file.filename.c_str());
-    *r_read_entries_len = 0;
-    return FILE_INDEXER_ENTRIES_LOADED;
+              "Asset index file [%s] needs to be refreshed as the size or modification time of the "
+              "asset file [%s] changed.",
+              asset_index_file.filename.c_str(),
+              filename);
+    return FILE_INDEXER_NEEDS_UPDATE;
   }
 
-  std::unique_ptr<AssetIndex> contents = asset_index_file.read_contents();
-  if (!contents->is_latest_version()) {
+  if (!contents->has_entries()) {
     CLOG_INFO(&LOG,
               3,
-              "Asset file index is ignored; expected version %d but file is version %d [%s].",
-              AssetIndex::CURRENT_VERSION,
-              contents->get_version(),
+              "Asset file index doesn't contain any entries. [%s]",
               asset_index_file.filename.c_str());
-    return FILE_INDEXER_NEEDS_UPDATE;
+    *r_read_entries_len = 0;
+    return FILE_INDEXER_ENTRIES_LOADED;
   }
 
   const int read_entries_len = contents->extract_into(*entries);
@@ -708,7 +681,7 @@ static void update_index(const char *filename, FileIndexerEntries *entries, void
             asset_file.get_file_path(),
             asset_index_file.get_file_path());
 
-  AssetIndex content(*entries);
+  AssetIndex content(asset_file, *entries);
   asset_index_file.write_contents(content);
 }
 
@@ -717,7 +690,6 @@ static void *init_user_data(const char *root_directory, size_t root_directory_ma
   AssetLibraryIndex *library_index = MEM_new<AssetLibraryIndex>(
       __func__, StringRef(root_directory, BLI_strnlen(root_directory, root_directory_maxncpy)));
   library_index->collect_preexisting_file_indices();
-  library_index->remove_broken_index_files();
   return library_index;
 }
 
@@ -1387,9 +1387,13 @@ void constraint_dependency_tag_update(Main *bmain, Object *ob, bConstraint *con)
   constraint_tag_update(bmain, ob, con);
 
   if (ob->pose) {
+    /* Pose channels might need to be rebuilt, which requires a full rebuild of the graph. */
     object_pose_tag_update(bmain, ob);
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_id_relations_tag_update(bmain, &ob->id);
   }
-  DEG_relations_tag_update(bmain);
 }
 
 bool constraint_move_to_index(Object *ob, bConstraint *con, const int index)
@@ -8,11 +8,14 @@
  * Wrapper between 'ED_undo.hh' and 'BKE_undo_system.hh' API's.
  */
 
+#include "CLG_log.h"
+
 #include "BLI_sys_types.h"
 #include "BLI_utildefines.h"
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_vector.hh"
 
 #include "DNA_ID.h"
 #include "DNA_collection_types.h"
@@ -20,6 +23,7 @@
 #include "DNA_object_enums.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_windowmanager_types.h"
 
 #include "BKE_blender_undo.hh"
 #include "BKE_context.hh"
@@ -45,15 +49,95 @@
 
 #include <cstdio>
 
-/* -------------------------------------------------------------------- */
-/** \name Implements ED Undo System
- * \{ */
+static CLG_LogRef LOG = {"ed.undo.memfile"};
 
 struct MemFileUndoStep {
   UndoStep step;
   MemFileUndoData *data;
 };
 
+/* -------------------------------------------------------------------- */
+/** \name Compression
+ *
+ * Steps which are not next to the active one are compressed when the undo memory limit is
+ * reached, and decompressed when they are needed again.
+ * \{ */
+
+static void memfile_undosys_stack_update_data_size(UndoStack *ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us_p, &ustack->steps) {
+    if (us_p->type == BKE_UNDOSYS_TYPE_MEMFILE && !us_p->use_encode_async) {
+      MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+      us->data->undo_size = us->data->memfile.size;
+      us->step.data_size = us->data->undo_size;
+    }
+  }
+}
+
+static void memfile_undosys_stack_compress(UndoStack *ustack)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_undo_compression)) {
+    return;
+  }
+  /* The step written in the background uses the previous one. */
+  BKE_undosys_stack_encode_async_wait(ustack);
+
+  /* Keep the steps used to undo, redo and write the next step as is. */
+  UndoStep *us_active_prev = ustack->step_active;
+  while (us_active_prev && us_active_prev->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+    us_active_prev = us_active_prev->prev;
+  }
+  UndoStep *us_active_next = BKE_undosys_step_same_type_next(
+      us_active_prev ? us_active_prev : ustack->step_active);
+
+  blender::Vector<MemFile *> memfiles;
+  blender::Vector<const MemFile *> memfiles_keep;
+  LISTBASE_FOREACH (UndoStep *, us_p, &ustack->steps) {
+    if (us_p->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+      continue;
+    }
+    MemFile *memfile = &((MemFileUndoStep *)us_p)->data->memfile;
+    if (ELEM(us_p, us_active_prev, us_active_next)) {
+      memfiles_keep.append(memfile);
+    }
+    else {
+      memfiles.append(memfile);
+    }
+  }
+  if (memfiles.is_empty()) {
+    return;
+  }
+  BLO_memfile_compress(memfiles, memfiles_keep);
+  memfile_undosys_stack_update_data_size(ustack);
+}
+
+/**
+ * Compressed data of \a us may be shared with any other step, all are updated.
+ *
+ * \return False when the data of \a us can't be decompressed, it must not be used then.
+ */
+static bool memfile_undosys_step_ensure_decompressed(UndoStack *ustack, MemFileUndoStep *us)
+{
+  blender::Vector<MemFile *> memfiles;
+  LISTBASE_FOREACH (UndoStep *, us_p, &ustack->steps) {
+    if (us_p->type == BKE_UNDOSYS_TYPE_MEMFILE) {
+      memfiles.append(&((MemFileUndoStep *)us_p)->data->memfile);
+    }
+  }
+  if (!BLO_memfile_decompress(memfiles, &us->data->memfile)) {
+    CLOG_ERROR(&LOG, "Failed to decompress undo step '%s'", us->step.name);
+    return false;
+  }
+  memfile_undosys_stack_update_data_size(ustack);
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Implements ED Undo System
+ * \{ */
+
 static bool memfile_undosys_poll(bContext *C)
 {
   /* other poll functions must run first, this is a catch-all. */
@@ -84,8 +168,15 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   /* can be null, use when set. */
   MemFileUndoStep *us_prev = (MemFileUndoStep *)BKE_undosys_step_find_by_type(
       ustack, BKE_UNDOSYS_TYPE_MEMFILE);
-  us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr);
+  if (us_prev && !memfile_undosys_step_ensure_decompressed(ustack, us_prev)) {
+    /* Write all data of the new step instead of comparing it with the previous one. */
+    us_prev = nullptr;
+  }
+  const bool use_async = USER_EXPERIMENTAL_TEST(&U, use_undo_async_push);
+  us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr, use_async);
   us->step.data_size = us->data->undo_size;
+  /* Changed geometry is written in the background, see #memfile_undosys_step_encode_async. */
+  us->step.use_encode_async = us->data->memfile.deferred_write != nullptr;
 
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
@@ -95,6 +186,19 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   return true;
 }
 
+static size_t memfile_undosys_step_encode_async(UndoStep *us_p)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  BKE_memfile_undo_encode_deferred(us->data);
+  return us->data->undo_size;
+}
+
+static void memfile_undosys_step_encode_async_end(UndoStep *us_p)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  BKE_memfile_undo_encode_deferred_end(us->data);
+}
+
 static int memfile_undosys_step_id_reused_cb(LibraryIDLinkCallbackData *cb_data)
 {
   ID *self_id = cb_data->self_id;
@@ -159,6 +263,14 @@ static void memfile_undosys_step_decode(
 {
   BLI_assert(undo_direction != STEP_INVALID);
 
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  wmWindowManager *wm = CTX_wm_manager(C);
+  if (!memfile_undosys_step_ensure_decompressed(wm->undo_stack, us)) {
+    /* Keep the current data, reading the step would corrupt it. */
+    WM_report(RPT_ERROR, "Undo step data is corrupt, it cannot be loaded");
+    return;
+  }
+
   bool use_old_bmain_data = true;
 
   if (USER_EXPERIMENTAL_TEST(&U, use_undo_legacy) || !(U.uiflag & USER_GLOBALUNDO)) {
@@ -199,9 +311,8 @@ static void memfile_undosys_step_decode(
   ED_editors_exit(bmain, false);
   /* Ensure there's no preview job running. Unfinished previews will be scheduled for regeneration
    * via #memfile_undosys_unfinished_id_previews_restart(). */
-  ED_preview_kill_jobs(CTX_wm_manager(C), bmain);
+  ED_preview_kill_jobs(wm, bmain);
 
-  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
@@ -330,9 +441,13 @@ void ED_memfile_undosys_type(UndoType *ut)
   ut->name = "Global Undo";
   ut->poll = memfile_undosys_poll;
   ut->step_encode = memfile_undosys_step_encode;
+  ut->step_encode_async = memfile_undosys_step_encode_async;
+  ut->step_encode_async_end = memfile_undosys_step_encode_async_end;
   ut->step_decode = memfile_undosys_step_decode;
   ut->step_free = memfile_undosys_step_free;
 
+  ut->stack_compress = memfile_undosys_stack_compress;
+
   ut->flags = 0;
 
   ut->step_size = sizeof(MemFileUndoStep);
@@ -356,6 +471,7 @@ static MemFile *ed_undosys_step_get_memfile(UndoStep *us_p)
 
 MemFile *ED_undosys_stack_memfile_get_if_active(UndoStack *ustack)
 {
+  BKE_undosys_stack_encode_async_wait(ustack);
   if (!ustack->step_active) {
     return nullptr;
   }
@@ -372,6 +488,7 @@ void ED_undosys_stack_memfile_id_changed_tag(UndoStack *ustack, ID *id)
     return;
   }
 
+  BKE_undosys_stack_encode_async_wait(ustack);
   MemFile *memfile = &((MemFileUndoStep *)us)->data->memfile;
   LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &memfile->chunks) {
     if (mem_chunk->id_session_uid == id->session_uid) {
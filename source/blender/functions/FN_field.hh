@@ -156,6 +156,12 @@ class GField : public GFieldBase<std::shared_ptr<FieldNode>> {
       : GFieldBase<std::shared_ptr<FieldNode>>(std::move(node), node_output_index)
   {
   }
+
+  /** Number of fields that reference the same node, including this one. */
+  int64_t node_users() const
+  {
+    return node_.use_count();
+  }
 };
 
 /**
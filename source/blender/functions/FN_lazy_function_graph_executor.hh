@@ -105,6 +105,11 @@ class GraphExecutor : public LazyFunction {
    * Optional wrapper for node execution functions.
    */
   const NodeExecuteWrapper *node_execute_wrapper_;
+  /**
+   * When more nodes than this are scheduled on one thread, half of them are moved into a separate
+   * task that other threads can work on.
+   */
+  int parallel_batch_threshold_ = 128;
 
   /**
    * When a graph is executed, various things have to be allocated (e.g. the state of all nodes).
@@ -128,6 +133,12 @@ class GraphExecutor : public LazyFunction {
                 const SideEffectProvider *side_effect_provider,
                 const NodeExecuteWrapper *node_execute_wrapper);
 
+  /**
+   * Use a lower threshold for distributing scheduled nodes to other threads. This is useful when
+   * the graph contains many independent nodes that are likely expensive, e.g. loop bodies.
+   */
+  void set_parallel_batch_threshold(int nodes_num);
+
   void *init_storage(LinearAllocator<> &allocator) const override;
   void destruct_storage(void *storage) const override;
 
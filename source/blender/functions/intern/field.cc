@@ -278,6 +278,25 @@ static void build_multi_function_procedure_for_fields(mf::Procedure &procedure,
   BLI_assert(procedure.validate());
 }
 
+/**
+ * Varying fields are evaluated in chunks that are small enough for the input slices, intermediate
+ * values and outputs of a chunk to stay in the L2 cache while the procedure is executed.
+ */
+static int64_t compute_chunk_size(const mf::Procedure &procedure)
+{
+  const int64_t target_bytes = 256 * 1024;
+  int64_t bytes_per_element = 0;
+  for (const mf::Variable *variable : procedure.variables()) {
+    const mf::DataType data_type = variable->data_type();
+    /* Vectors are stored in a separate allocation per element, so their size is only a guess. */
+    bytes_per_element += data_type.is_single() ? data_type.single_type().size() : 32;
+  }
+  if (bytes_per_element == 0) {
+    return 10000;
+  }
+  return std::clamp<int64_t>(target_bytes / bytes_per_element, 512, 10000);
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 const IndexMask &mask,
@@ -373,14 +392,9 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         procedure, scope, field_tree_info, varying_fields_to_evaluate);
     mf::ProcedureExecutor procedure_executor{procedure};
 
-    mf::ParamsBuilder mf_params{procedure_executor, &mask};
-    mf::ContextBuilder mf_context;
-
-    /* Provide inputs to the procedure executor. */
-    for (const GVArray &varray : field_context_inputs) {
-      mf_params.add_readonly_single_input(varray);
-    }
-
+    /* Buffer that each output is written to, or null if it is moved into a virtual array provided
+     * by the caller directly. */
+    Array<void *> output_buffers(varying_fields_to_evaluate.size());
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
       const CPPType &type = field.cpp_type();
@@ -388,10 +402,10 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
       /* Try to get an existing virtual array that the result should be written into. */
       GVMutableArray dst_varray = get_dst_varray(out_index);
-      void *buffer;
-      if (!dst_varray || !dst_varray.is_span()) {
+      if (!dst_varray) {
         /* Allocate a new buffer for the computed result. */
-        buffer = scope.linear_allocator().allocate(type.size() * array_size, type.alignment());
+        void *buffer = scope.linear_allocator().allocate(type.size() * array_size,
+                                                         type.alignment());
 
         if (!type.is_trivially_destructible()) {
           /* Destruct values in the end. */
@@ -400,21 +414,77 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
         }
 
         r_varrays[out_index] = GVArray::ForSpan({type, buffer, array_size});
+        output_buffers[i] = buffer;
       }
       else {
-        /* Write the result into the existing span. */
-        buffer = dst_varray.get_internal_span().data();
-
+        /* Write the result into the existing span, or chunk by chunk into the virtual array. */
+        output_buffers[i] = dst_varray.is_span() ? dst_varray.get_internal_span().data() :
+                                                   nullptr;
         r_varrays[out_index] = dst_varray;
         is_output_written_to_dst[out_index] = true;
       }
-
-      /* Pass output buffer to the procedure executor. */
-      const GMutableSpan span{type, buffer, array_size};
-      mf_params.add_uninitialized_single_output(span);
     }
 
-    procedure_executor.call_auto(mask, mf_params, mf_context);
+    const int64_t chunk_size = compute_chunk_size(procedure);
+    threading::parallel_for(mask.index_range(), chunk_size, [&](const IndexRange range) {
+      /* Buffers for results that are moved into a virtual array, reused for every chunk. They
+       * only have to grow when the mask has gaps. */
+      LinearAllocator<> allocator;
+      Array<GMutableSpan> chunk_buffers(varying_fields_to_evaluate.size());
+
+      for (int64_t start = 0; start < range.size(); start += chunk_size) {
+        const IndexRange chunk = range.slice(start, std::min(chunk_size, range.size() - start));
+        /* Evaluate the chunk as if the indices started at zero, so that the chunk buffers are
+         * indexed directly. */
+        const int64_t offset = mask[chunk.first()];
+        const IndexRange input_range = IndexRange::from_begin_end_inclusive(offset,
+                                                                            mask[chunk.last()]);
+        IndexMaskMemory memory;
+        const IndexMask chunk_mask = mask.slice_and_shift(chunk, -offset, memory);
+
+        mf::ParamsBuilder mf_params{procedure_executor, &chunk_mask};
+        mf::ContextBuilder mf_context;
+
+        /* Provide inputs to the procedure executor. */
+        for (const GVArray &varray : field_context_inputs) {
+          mf_params.add_readonly_single_input(varray.slice(input_range));
+        }
+
+        for (const int i : varying_fields_to_evaluate.index_range()) {
+          const CPPType &type = varying_fields_to_evaluate[i].cpp_type();
+          if (output_buffers[i] != nullptr) {
+            /* Write directly into the final location. */
+            mf_params.add_uninitialized_single_output(
+                GMutableSpan{type, output_buffers[i], array_size}.slice(input_range));
+          }
+          else {
+            if (chunk_buffers[i].size() < input_range.size()) {
+              chunk_buffers[i] = {type,
+                                  allocator.allocate(type.size() * input_range.size(),
+                                                     type.alignment()),
+                                  input_range.size()};
+            }
+            mf_params.add_uninitialized_single_output(
+                chunk_buffers[i].take_front(input_range.size()));
+          }
+        }
+
+        procedure_executor.call(chunk_mask, mf_params, mf_context);
+
+        /* Move values from the chunk buffers into the destination virtual arrays while they are
+         * still in the CPU cache. */
+        for (const int i : varying_fields_to_evaluate.index_range()) {
+          if (output_buffers[i] != nullptr) {
+            continue;
+          }
+          GVMutableArray dst_varray = get_dst_varray(varying_field_indices[i]);
+          const GMutableSpan buffer = chunk_buffers[i];
+          chunk_mask.foreach_index([&](const int64_t index) {
+            dst_varray.set_by_relocate(index + offset, buffer[index]);
+          });
+        }
+      }
+    });
   }
 
   /* Evaluate constant fields if necessary. */
@@ -816,7 +816,7 @@ class Executor {
 
       /* If there are many nodes scheduled at the same time, it's beneficial to let multiple
        * threads work on those. */
-      if (current_task.scheduled_nodes.nodes_num() > 128) {
+      if (current_task.scheduled_nodes.nodes_num() > self_.parallel_batch_threshold_) {
         if (this->try_enable_multi_threading()) {
           std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
           current_task.scheduled_nodes.split_into(*split_nodes);
@@ -1525,6 +1525,12 @@ void GraphExecutor::execute_impl(Params &params, const Context &context) const
   executor.execute(params, context);
 }
 
+void GraphExecutor::set_parallel_batch_threshold(const int nodes_num)
+{
+  BLI_assert(nodes_num >= 1);
+  parallel_batch_threshold_ = nodes_num;
+}
+
 void *GraphExecutor::init_storage(LinearAllocator<> &allocator) const
 {
   Executor &executor = *allocator.construct<Executor>(*this).release();
@@ -281,4 +281,64 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+TEST(field, GappedMaskLargerThanChunk)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  GField output_field{FieldOperation::Create(add_fn, {index_field, index_field}), 0};
+
+  /* The mask has gaps and more elements than fit into a single chunk. */
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(40000), GrainSize(4096), memory, [](const int64_t i) { return i % 3 == 0; });
+  EXPECT_GT(mask.size(), 10000);
+
+  Array<int> result(40000, -1);
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(output_field, result.as_mutable_span());
+  evaluator.evaluate();
+  for (const int i : result.index_range()) {
+    EXPECT_EQ(result[i], i % 3 == 0 ? i * 2 : -1);
+  }
+}
+
+static int get_first(const std::array<int, 2> &value)
+{
+  return value[0];
+}
+
+static void set_first(std::array<int, 2> &value, const int first)
+{
+  value[0] = first;
+}
+
+TEST(field, NonSpanDestination)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  GField output_field{FieldOperation::Create(add_fn, {index_field, index_field}), 0};
+
+  Array<std::array<int, 2>> result(25000, {-1, -1});
+  GVMutableArray dst_varray =
+      VMutableArray<int>::ForDerivedSpan<std::array<int, 2>, get_first, set_first>(result);
+  EXPECT_FALSE(dst_varray.is_span());
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(25000), GrainSize(4096), memory, [](const int64_t i) { return i % 5 != 2; });
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(output_field, dst_varray);
+  evaluator.evaluate();
+  for (const int i : result.index_range()) {
+    EXPECT_EQ(result[i][0], i % 5 != 2 ? i * 2 : -1);
+    EXPECT_EQ(result[i][1], -1);
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -149,6 +149,20 @@ bool DNA_struct_member_exists_without_alias(const struct SDNA *sdna,
  * \param data: Struct data that is to be converted
  */
 void DNA_struct_switch_endian(const struct SDNA *sdna, int struct_index, char *data);
+/**
+ * Check whether a struct (or any of its nested structs) has pointer members,
+ * i.e. whether its data can be used as is, without remapping addresses after reading.
+ */
+bool DNA_struct_contains_pointers(const struct SDNA *sdna, int struct_index);
+/**
+ * Call \a callback for each pointer member of a struct value (including the ones of nested
+ * structs), so they can be read or replaced. \a sdna must use the pointer size of this platform.
+ */
+void DNA_struct_foreach_pointer(const struct SDNA *sdna,
+                                int struct_index,
+                                char *data,
+                                void (*callback)(void **pointer, void *user_data),
+                                void *user_data);
 /**
  * Constructs and returns an array of byte flags with one element for each struct in oldsdna,
  * indicating how it compares to newsdna.
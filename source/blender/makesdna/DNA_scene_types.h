@@ -2187,7 +2187,8 @@ enum {
   R_SIMPLIFY = 1 << 24,
   R_EDGE_FRS = 1 << 25,        /* R_EDGE reserved for Freestyle */
   R_PERSISTENT_DATA = 1 << 26, /* Keep data around for re-render. */
-  R_MODE_UNUSED_27 = 1 << 27,  /* cleared */
+  /** Keep the evaluated depsgraph of the render engine between frames of animation renders. */
+  R_PERSISTENT_DEPSGRAPH = 1 << 27,
 };
 
 /** #RenderData::seq_flag */
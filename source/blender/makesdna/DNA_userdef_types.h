@@ -747,6 +747,7 @@ typedef struct UserDef_Experimental {
   char use_all_linked_data_direct;
   char use_extensions_debug;
   char use_recompute_usercount_on_save_debug;
+  char no_geometry_nodes_memoization;
   char SANITIZE_AFTER_HERE;
   /* The following options are automatically sanitized (set to 0)
    * when the release cycle is not alpha. */
@@ -761,7 +762,13 @@ typedef struct UserDef_Experimental {
   char use_shader_node_previews;
   char use_animation_baklava;
   char enable_new_cpu_compositor;
-  char _pad[2];
+  char use_mmap_shared_data;
+  char use_undo_skip_unchanged_ids;
+  char use_undo_async_push;
+  char use_undo_compression;
+  char use_depsgraph_incremental_relations;
+  char use_blend_file_index;
+  char _pad[3];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -1172,6 +1172,73 @@ void DNA_struct_switch_endian(const SDNA *sdna, int struct_index, char *data)
   }
 }
 
+bool DNA_struct_contains_pointers(const SDNA *sdna, const int struct_index)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_index];
+  for (int member_index = 0; member_index < struct_info->members_num; member_index++) {
+    const SDNA_StructMember *member = &struct_info->members[member_index];
+    switch (get_struct_member_category(sdna, member)) {
+      case STRUCT_MEMBER_CATEGORY_POINTER: {
+        return true;
+      }
+      case STRUCT_MEMBER_CATEGORY_STRUCT: {
+        const char *member_type_name = sdna->types[member->type_index];
+        const int substruct_index = DNA_struct_find_index_without_alias(sdna, member_type_name);
+        BLI_assert(substruct_index != -1);
+        if (DNA_struct_contains_pointers(sdna, substruct_index)) {
+          return true;
+        }
+        break;
+      }
+      case STRUCT_MEMBER_CATEGORY_PRIMITIVE: {
+        break;
+      }
+    }
+  }
+  return false;
+}
+
+void DNA_struct_foreach_pointer(const SDNA *sdna,
+                                const int struct_index,
+                                char *data,
+                                void (*callback)(void **pointer, void *user_data),
+                                void *user_data)
+{
+  BLI_assert(sdna->pointer_size == sizeof(void *));
+  const SDNA_Struct *struct_info = sdna->structs[struct_index];
+
+  int offset_in_bytes = 0;
+  for (int member_index = 0; member_index < struct_info->members_num; member_index++) {
+    const SDNA_StructMember *member = &struct_info->members[member_index];
+    char *member_data = data + offset_in_bytes;
+    const int member_array_length = sdna->members_array_num[member->member_index];
+
+    switch (get_struct_member_category(sdna, member)) {
+      case STRUCT_MEMBER_CATEGORY_STRUCT: {
+        const char *member_type_name = sdna->types[member->type_index];
+        const int substruct_size = sdna->types_size[member->type_index];
+        const int substruct_index = DNA_struct_find_index_without_alias(sdna, member_type_name);
+        BLI_assert(substruct_index != -1);
+        for (int a = 0; a < member_array_length; a++) {
+          DNA_struct_foreach_pointer(
+              sdna, substruct_index, member_data + a * substruct_size, callback, user_data);
+        }
+        break;
+      }
+      case STRUCT_MEMBER_CATEGORY_POINTER: {
+        for (int a = 0; a < member_array_length; a++) {
+          callback(reinterpret_cast<void **>(member_data) + a, user_data);
+        }
+        break;
+      }
+      case STRUCT_MEMBER_CATEGORY_PRIMITIVE: {
+        break;
+      }
+    }
+    offset_in_bytes += get_member_size_in_bytes(sdna, member);
+  }
+}
+
 enum eReconstructStepType {
   RECONSTRUCT_STEP_MEMCPY,
   RECONSTRUCT_STEP_CAST_PRIMITIVE,
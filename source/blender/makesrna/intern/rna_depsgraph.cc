@@ -515,6 +515,11 @@ static bool rna_Depsgraph_id_type_updated(Depsgraph *depsgraph, int id_type)
   return DEG_id_type_updated(depsgraph, id_type);
 }
 
+static float rna_Depsgraph_id_evaluated_memory_get(Depsgraph *depsgraph, ID *id)
+{
+  return float(double(DEG_get_evaluated_memory_for_id(depsgraph, id)) / (1024.0 * 1024.0));
+}
+
 static PointerRNA rna_Depsgraph_scene_get(PointerRNA *ptr)
 {
   Depsgraph *depsgraph = (Depsgraph *)ptr->data;
@@ -785,6 +790,18 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                          "True if any datablock with this type was added, updated or removed");
   RNA_def_function_return(func, parm);
 
+  func = RNA_def_function(
+      srna, "id_evaluated_memory_get", "rna_Depsgraph_id_evaluated_memory_get");
+  RNA_def_function_ui_description(
+      func,
+      "Memory used by the evaluated data of the ID (like the evaluated geometry of an object) "
+      "after its last evaluation. Data shared with other IDs is included");
+  parm = RNA_def_pointer(func, "id", "ID", "", "Original or evaluated ID");
+  RNA_def_parameter_flags(parm, PropertyFlag(0), PARM_REQUIRED);
+  parm = RNA_def_float(
+      func, "memory", 0.0f, 0.0f, FLT_MAX, "Memory", "Memory in megabytes", 0.0f, FLT_MAX);
+  RNA_def_function_return(func, parm);
+
   prop = RNA_def_property(srna, "scene_eval", PROP_POINTER, PROP_NONE);
   RNA_def_property_struct_type(prop, "Scene");
   RNA_def_property_pointer_funcs(prop, "rna_Depsgraph_scene_eval_get", nullptr, nullptr, nullptr);
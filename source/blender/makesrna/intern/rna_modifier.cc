@@ -938,7 +938,7 @@ static void rna_Modifier_update(Main * /*bmain*/, Scene * /*scene*/, PointerRNA
 static void rna_Modifier_dependency_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   rna_Modifier_update(bmain, scene, ptr);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, ptr->owner_id);
 }
 
 static void rna_NodesModifier_bake_update(Main *bmain, Scene *scene, PointerRNA *ptr)
@@ -7502,6 +7502,15 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
                            "at the cost of increased memory usage");
   RNA_def_property_update(prop, 0, "rna_Scene_use_persistent_data_update");
 
+  prop = RNA_def_property(srna, "use_persistent_depsgraph", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_PERSISTENT_DEPSGRAPH);
+  RNA_def_property_ui_text(prop,
+                           "Persistent Depsgraph",
+                           "Keep the evaluated scene between frames of animation renders, only "
+                           "re-evaluating what changes over time, at the cost of increased memory "
+                           "usage while rendering");
+  RNA_def_property_update(prop, 0, "rna_Scene_use_persistent_data_update");
+
   /* Freestyle line thickness options */
   prop = RNA_def_property(srna, "line_thickness_mode", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, nullptr, "line_thickness_mode");
@@ -7549,6 +7549,52 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, nullptr, "enable_new_cpu_compositor", 1);
   RNA_def_property_ui_text(prop, "CPU Compositor", "Enable the new CPU compositor");
 
+  prop = RNA_def_property(srna, "use_mmap_shared_data", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_mmap_shared_data", 1);
+  RNA_def_property_ui_text(prop,
+                           "Memory-Mapped Shared Data",
+                           "Reference large arrays (mesh attributes, offsets, packed files) "
+                           "directly from the memory-mapped blend-file instead of copying them "
+                           "on load. The file must not be modified in place while it is open");
+
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data",
+                           "Speed up global undo steps by not storing again geometry data-blocks "
+                           "which were not tagged as changed since the previous step");
+
+  prop = RNA_def_property(srna, "use_undo_async_push", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_undo_async_push", 1);
+  RNA_def_property_ui_text(prop,
+                           "Asynchronous Undo Push",
+                           "Store changed geometry data-blocks of global undo steps in a "
+                           "background thread, from a copy taken when the step is pushed");
+
+  prop = RNA_def_property(srna, "use_undo_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_undo_compression", 1);
+  RNA_def_property_ui_text(prop,
+                           "Compress Undo Steps",
+                           "When the undo memory limit is reached, compress global undo steps "
+                           "which are not next to the current one before removing the oldest "
+                           "steps");
+
+  prop = RNA_def_property(srna, "use_depsgraph_incremental_relations", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_depsgraph_incremental_relations", 1);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Depsgraph Relations",
+                           "When the dependencies of an object change (for example the target of "
+                           "a modifier), only update the relations of this object instead of "
+                           "rebuilding the whole dependency graph");
+
+  prop = RNA_def_property(srna, "use_blend_file_index", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "use_blend_file_index", 1);
+  RNA_def_property_ui_text(prop,
+                           "Blend-File Index",
+                           "Keep an index of the data-blocks of libraries in the cache directory, "
+                           "so that listing them when loading libraries from Python doesn't "
+                           "require reading the files again");
+
   prop = RNA_def_property(srna, "use_all_linked_data_direct", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
@@ -7583,6 +7629,14 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
                            "work around invalid usercount handling in code that may lead to loss "
                            "of data due to wrongly detected unused data-blocks");
 
+  prop = RNA_def_property(srna, "no_geometry_nodes_memoization", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "no_geometry_nodes_memoization", 1);
+  RNA_def_property_ui_text(prop,
+                           "No Geometry Nodes Memoization",
+                           "Always execute geometry nodes, instead of reusing their outputs from "
+                           "the memory cache when they are evaluated again with the same inputs");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "use_animation_baklava", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "use_animation_baklava", 1);
   RNA_def_property_ui_text(
@@ -94,6 +94,7 @@
 #include "NOD_geometry_nodes_execute.hh"
 #include "NOD_geometry_nodes_gizmos.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_profile.hh"
 #include "NOD_node_declaration.hh"
 
 #include "FN_field.hh"
@@ -1831,6 +1832,14 @@ static void modifyGeometry(ModifierData *md,
     find_socket_log_contexts(*nmd, *ctx, socket_log_contexts);
     call_data.socket_log_contexts = &socket_log_contexts;
   }
+  if (geo_log::profile_is_enabled() && (ctx->flag & MOD_APPLY_ORCO) == 0) {
+    call_data.log_profile = true;
+    if (!call_data.eval_log) {
+      /* The profile is gathered from the log, but socket values are not needed for it. */
+      call_data.eval_log = eval_log.get();
+      call_data.socket_log_contexts = &socket_log_contexts;
+    }
+  }
 
   nodes::GeoNodesSideEffectNodes side_effect_nodes;
   find_side_effect_nodes(*nmd, *ctx, side_effect_nodes, socket_log_contexts);
@@ -1844,6 +1853,11 @@ static void modifyGeometry(ModifierData *md,
                                                            call_data,
                                                            std::move(geometry_set));
 
+  if (call_data.log_profile) {
+    geo_log::profile_add_evaluation(
+        *eval_log, modifier_compute_context.hash(), tree, DEG_get_ctime(ctx->depsgraph));
+  }
+
   if (logging_enabled(ctx)) {
     nmd_orig->runtime->eval_log = std::move(eval_log);
   }
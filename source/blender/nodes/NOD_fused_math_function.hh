@@ -0,0 +1,78 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ */
+
+#include <array>
+#include <optional>
+
+#include "FN_field.hh"
+#include "FN_multi_function.hh"
+
+namespace blender::nodes {
+
+/**
+ * Multi-function of the Math node that can be fused with the Math nodes computing its inputs.
+ *
+ * When a Math node is evaluated on fields, and some of its input fields come from other Math
+ * nodes, the operations of all those nodes are merged into a single field operation (see
+ * #try_fuse_fields). The merged operations are executed one after another on small blocks of
+ * elements using pre-generated kernels, so that the intermediate values stay in the CPU cache
+ * instead of going through a full-size buffer for every node.
+ */
+class FusedFloatMathFunction : public mf::MultiFunction {
+ public:
+  /** Computes the result of one operation for `n` consecutive elements. */
+  using KernelFn = void (*)(const float *const *args, float *r_values, int64_t n);
+
+  struct Operation {
+    KernelFn kernel;
+    bool clamp;
+    int args_num;
+    /**
+     * A positive value references the result of an earlier operation, a negative value references
+     * the function input with the index `-arg - 1`.
+     */
+    std::array<int, 3> args;
+  };
+
+  /** Upper limit for the number of fused operations, so that the block buffers stay small. */
+  static constexpr int max_operations = 64;
+
+ private:
+  /** Used instead of the kernels when only a single operation is evaluated. */
+  const mf::MultiFunction *base_fn_ = nullptr;
+  int inputs_num_;
+  Vector<Operation> operations_;
+  mf::Signature signature_;
+
+ public:
+  /**
+   * Evaluates a single #NodeMathOperation by calling the given function, which is expected to be
+   * more efficient than the kernels when there is nothing to fuse.
+   */
+  FusedFloatMathFunction(const mf::MultiFunction &base_fn, int operation, bool clamp);
+  FusedFloatMathFunction(int inputs_num, Vector<Operation> operations);
+
+  /**
+   * Build a field that evaluates this function with the given inputs, inlining the operations of
+   * input fields that are computed by a #FusedFloatMathFunction as well. Input fields that have
+   * other users are not inlined, because their operations would be computed again.
+   * \return Empty if no input can be fused.
+   */
+  std::optional<fn::GField> try_fuse_fields(Span<fn::GField> inputs) const;
+
+  Span<Operation> operations() const
+  {
+    return operations_;
+  }
+
+  void call(const IndexMask &mask, mf::Params params, mf::Context context) const override;
+};
+
+}  // namespace blender::nodes
@@ -76,6 +76,7 @@ class GeoNodeExecParams {
   const Span<int> lf_input_for_output_bsocket_usage_;
   const Span<int> lf_input_for_attribute_propagation_to_output_;
   const FunctionRef<std::string(int)> get_output_attribute_id_;
+  Vector<geo_eval_log::NodeWarning> *r_warnings_ = nullptr;
 
  public:
   GeoNodeExecParams(const bNode &node,
@@ -264,6 +265,15 @@ class GeoNodeExecParams {
    */
   void error_message_add(const NodeWarningType type, StringRef message) const;
 
+  /**
+   * Also store the warnings added by the node in the given vector, so that they can be logged
+   * again when the outputs of the node are reused without executing it.
+   */
+  void record_warnings(Vector<geo_eval_log::NodeWarning> &r_warnings)
+  {
+    r_warnings_ = &r_warnings;
+  }
+
   void set_default_remaining_outputs();
 
   void used_named_attribute(StringRef attribute_name, NamedAttributeUsage usage);
@@ -43,6 +43,8 @@ namespace blender::nodes {
 using lf::LazyFunction;
 using mf::MultiFunction;
 
+struct RepeatZoneInvariantCache;
+
 /** The structs in here describe the different possible behaviors of a simulation input node. */
 namespace sim_input {
 
@@ -238,6 +240,12 @@ struct GeoNodesCallData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /**
+   * Log additional statistics about every executed node to #eval_log, which are gathered for the
+   * profile written when using the `--profile-geometry-nodes` command line argument. Computing
+   * them has a small cost for every node.
+   */
+  bool log_profile = false;
 
   /**
    * Data from the modifier that is being evaluated.
@@ -272,6 +280,11 @@ struct GeoNodesLFUserData : public lf::UserData {
    * Log socket values in the current compute context. Child contexts might use logging again.
    */
   bool log_socket_values = true;
+  /**
+   * Outputs of nodes in the body of the repeat zone that is currently evaluated, which are the
+   * same in every iteration and are therefore only computed once.
+   */
+  RepeatZoneInvariantCache *repeat_zone_invariant_cache = nullptr;
 
   destruct_ptr<lf::LocalUserData> get_local(LinearAllocator<> &allocator) override;
 };
@@ -217,6 +217,18 @@ class GeoTreeLogger {
     TimePoint start;
     TimePoint end;
   };
+  struct NodeProfile {
+    int32_t node_id;
+    /** Number of points and instances in all output geometries. */
+    int64_t output_elements;
+    /** Memory used by the output geometries. */
+    int64_t output_bytes;
+  };
+  struct NodeInputRequest {
+    int32_t node_id;
+    /** Time at which the node had to wait for inputs that were not computed yet. */
+    TimePoint time;
+  };
   struct ViewerNodeLogWithNode {
     int32_t node_id;
     destruct_ptr<ViewerNodeLog> viewer_log;
@@ -238,6 +250,9 @@ class GeoTreeLogger {
   linear_allocator::ChunkedList<SocketValueLog, 16> input_socket_values;
   linear_allocator::ChunkedList<SocketValueLog, 16> output_socket_values;
   linear_allocator::ChunkedList<NodeExecutionTime, 16> node_execution_times;
+  /** Only logged when profiling is enabled, see #GeoNodesCallData::log_profile. */
+  linear_allocator::ChunkedList<NodeProfile> node_profiles;
+  linear_allocator::ChunkedList<NodeInputRequest> node_input_requests;
   linear_allocator::ChunkedList<ViewerNodeLogWithNode> viewer_node_logs;
   linear_allocator::ChunkedList<AttributeUsageWithNode> used_named_attributes;
   linear_allocator::ChunkedList<DebugMessage> debug_messages;
@@ -265,6 +280,15 @@ class GeoNodeLog {
   VectorSet<NodeWarning> warnings;
   /** Time spent in this node. */
   std::chrono::nanoseconds execution_time{0};
+  /** Number of times the node has been executed. */
+  int executions_num = 0;
+  /**
+   * Time between the node requesting inputs that were not available yet and its execution. This
+   * and the output statistics below are only available when profiling is enabled.
+   */
+  std::chrono::nanoseconds input_wait_time{0};
+  int64_t output_elements = 0;
+  int64_t output_bytes = 0;
   /** Maps from socket indices to their values. */
   Map<int, ValueLog *> input_values_;
   Map<int, ValueLog *> output_values_;
@@ -293,6 +317,7 @@ class GeoTreeLog {
   VectorSet<ComputeContextHash> children_hashes_;
   bool reduced_node_warnings_ = false;
   bool reduced_execution_times_ = false;
+  bool reduced_node_profiles_ = false;
   bool reduced_socket_values_ = false;
   bool reduced_viewer_node_logs_ = false;
   bool reduced_existing_attributes_ = false;
@@ -314,6 +339,7 @@ class GeoTreeLog {
 
   void ensure_node_warnings(const bNodeTree *tree);
   void ensure_execution_times();
+  void ensure_node_profiles();
   void ensure_socket_values();
   void ensure_viewer_node_logs();
   void ensure_existing_attributes();
@@ -321,6 +347,10 @@ class GeoTreeLog {
   void ensure_debug_messages();
   void ensure_evaluated_gizmo_nodes();
 
+  /** Node in the parent compute context that this tree is evaluated by (e.g. a group node). */
+  std::optional<int32_t> parent_node_id() const;
+  Span<ComputeContextHash> children_hashes() const;
+
   ValueLog *find_socket_value_log(const bNodeSocket &query_socket);
   [[nodiscard]] bool try_convert_primitive_socket_value(const GenericValueLog &value_log,
                                                         const CPPType &dst_type,
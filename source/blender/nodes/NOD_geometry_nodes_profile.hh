@@ -0,0 +1,44 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Gathers statistics about every node over all geometry nodes evaluations of a Blender session,
+ * e.g. while rendering an animation on a render farm. This is enabled with the
+ * `--profile-geometry-nodes <filepath>` command line argument. The aggregated statistics are
+ * written to that file when Blender exits, as JSON when the file name ends with `.json` and as
+ * CSV otherwise.
+ *
+ * The statistics are based on the data in #GeoModifierLog, which has to be created with
+ * #GeoNodesCallData::log_profile enabled.
+ */
+
+#include "BLI_compute_context.hh"
+#include "BLI_string_ref.hh"
+
+struct bNodeTree;
+
+namespace blender::nodes::geo_eval_log {
+
+class GeoModifierLog;
+
+/** True when statistics should be gathered during evaluation. */
+bool profile_is_enabled();
+
+/**
+ * Add the statistics that have been logged while evaluating the given node tree once.
+ * \param frame: Scene frame of the evaluation, which is used to compute the time per frame.
+ */
+void profile_add_evaluation(GeoModifierLog &log,
+                            const ComputeContextHash &root_context_hash,
+                            const bNodeTree &tree,
+                            float frame);
+
+/** Write all gathered statistics to the file passed on the command line, if any. */
+void profile_write();
+
+}  // namespace blender::nodes::geo_eval_log
@@ -613,6 +613,7 @@ static void node_register()
   blender::bke::node_type_size(&ntype, 170, 100, 320);
   ntype.declare = node_declare;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_memoize = true;
   ntype.draw_buttons = node_layout;
   ntype.draw_buttons_ex = node_layout_ex;
   blender::bke::node_register_type(&ntype);
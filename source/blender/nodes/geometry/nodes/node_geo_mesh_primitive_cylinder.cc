@@ -149,6 +149,7 @@ static void node_register()
       &ntype, "NodeGeometryMeshCylinder", node_free_standard_storage, node_copy_standard_storage);
   ntype.declare = node_declare;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_memoize = true;
   ntype.draw_buttons = node_layout;
   blender::bke::node_register_type(&ntype);
 
@@ -228,6 +228,7 @@ static void node_register()
       &ntype, GEO_NODE_SUBDIVISION_SURFACE, "Subdivision Surface", NODE_CLASS_GEOMETRY);
   ntype.declare = node_declare;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_memoize = true;
   ntype.draw_buttons = node_layout;
   ntype.initfunc = node_init;
   bke::node_type_size_preset(&ntype, bke::eNodeSizePreset::Middle);
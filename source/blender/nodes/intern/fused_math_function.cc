@@ -0,0 +1,288 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_map.hh"
+
+#include "NOD_fused_math_function.hh"
+#include "NOD_math_functions.hh"
+
+namespace blender::nodes {
+
+using KernelFn = FusedFloatMathFunction::KernelFn;
+
+/**
+ * Elements are processed in blocks of this size. The block buffers of all inputs and intermediate
+ * results of typical chains of operations fit into the L1 cache together, while the blocks are
+ * still large enough for the loops in the kernels to dominate the cost of calling them.
+ */
+static constexpr int64_t block_size = 256;
+
+/**
+ * Kernels are generated from the same math functions as the multi-functions of the Math node. The
+ * math function is copied into a static variable, so that it can be inlined into the kernel loop
+ * without being captured.
+ */
+static KernelFn get_kernel(const int operation, int &r_args_num)
+{
+  KernelFn kernel = nullptr;
+  try_dispatch_float_math_fl_to_fl(
+      operation, [&](auto /*exec_preset*/, auto math_function, const auto & /*info*/) {
+        static const auto element_fn = math_function;
+        kernel = [](const float *const *args, float *r_values, const int64_t n) {
+          const float *a = args[0];
+          for (int64_t i = 0; i < n; i++) {
+            r_values[i] = element_fn(a[i]);
+          }
+        };
+        r_args_num = 1;
+      });
+  try_dispatch_float_math_fl_fl_to_fl(
+      operation, [&](auto /*exec_preset*/, auto math_function, const auto & /*info*/) {
+        static const auto element_fn = math_function;
+        kernel = [](const float *const *args, float *r_values, const int64_t n) {
+          const float *a = args[0];
+          const float *b = args[1];
+          for (int64_t i = 0; i < n; i++) {
+            r_values[i] = element_fn(a[i], b[i]);
+          }
+        };
+        r_args_num = 2;
+      });
+  try_dispatch_float_math_fl_fl_fl_to_fl(
+      operation, [&](auto /*exec_preset*/, auto math_function, const auto & /*info*/) {
+        static const auto element_fn = math_function;
+        kernel = [](const float *const *args, float *r_values, const int64_t n) {
+          const float *a = args[0];
+          const float *b = args[1];
+          const float *c = args[2];
+          for (int64_t i = 0; i < n; i++) {
+            r_values[i] = element_fn(a[i], b[i], c[i]);
+          }
+        };
+        r_args_num = 3;
+      });
+  return kernel;
+}
+
+FusedFloatMathFunction::FusedFloatMathFunction(const mf::MultiFunction &base_fn,
+                                               const int operation,
+                                               const bool clamp)
+    : base_fn_(&base_fn)
+{
+  Operation op;
+  op.kernel = get_kernel(operation, op.args_num);
+  BLI_assert(op.kernel != nullptr);
+  op.clamp = clamp;
+  for (const int i : IndexRange(op.args_num)) {
+    op.args[i] = -i - 1;
+  }
+  inputs_num_ = op.args_num;
+  operations_.append(op);
+  BLI_assert(base_fn.param_amount() == inputs_num_ + 1);
+  this->set_signature(&base_fn.signature());
+}
+
+FusedFloatMathFunction::FusedFloatMathFunction(const int inputs_num, Vector<Operation> operations)
+    : inputs_num_(inputs_num), operations_(std::move(operations))
+{
+  mf::SignatureBuilder builder{"Fused Math", signature_};
+  for ([[maybe_unused]] const int i : IndexRange(inputs_num)) {
+    builder.single_input<float>("Value");
+  }
+  builder.single_output<float>("Value");
+  this->set_signature(&signature_);
+}
+
+namespace {
+
+/** Gathers the operations and inputs of a new fused function. */
+struct FusionBuilder {
+  Vector<fn::GField> inputs;
+  Map<fn::GField, int> arg_by_input;
+  /** Fused functions that have been inlined already, so that shared inputs are inlined once. */
+  Map<const fn::FieldNode *, int> arg_by_inlined_node;
+  Vector<FusedFloatMathFunction::Operation> operations;
+  /** Number of times each node is referenced by the inputs of the function that is fused. */
+  Map<const fn::FieldNode *, int64_t> uses_by_node;
+  bool inlined_any = false;
+
+  int add_input(const fn::GField &field)
+  {
+    const int input_index = arg_by_input.lookup_or_add_cb(field, [&]() {
+      inputs.append(field);
+      return inputs.size() - 1;
+    });
+    return -input_index - 1;
+  }
+
+  /** \return The argument that references the result of the last operation. */
+  int append_operations(const Span<FusedFloatMathFunction::Operation> src_operations,
+                        const Span<int> src_args)
+  {
+    const int offset = operations.size();
+    for (FusedFloatMathFunction::Operation op : src_operations) {
+      for (const int i : IndexRange(op.args_num)) {
+        const int arg = op.args[i];
+        op.args[i] = arg < 0 ? src_args[-arg - 1] : arg + offset;
+      }
+      operations.append(op);
+    }
+    return operations.size() - 1;
+  }
+
+  int add_field(const fn::GField &field)
+  {
+    if (const int *arg = arg_by_inlined_node.lookup_ptr(&field.node())) {
+      return *arg;
+    }
+    const auto *operation = dynamic_cast<const fn::FieldOperation *>(&field.node());
+    if (operation == nullptr) {
+      return this->add_input(field);
+    }
+    const auto *fused_fn = dynamic_cast<const FusedFloatMathFunction *>(
+        &operation->multi_function());
+    if (fused_fn == nullptr) {
+      return this->add_input(field);
+    }
+    /* Fields that are used elsewhere as well are not inlined, otherwise their operations would be
+     * computed once more for every user. */
+    if (field.node_users() > uses_by_node.lookup_default(&field.node(), 0)) {
+      return this->add_input(field);
+    }
+    const Span<FusedFloatMathFunction::Operation> src_operations = fused_fn->operations();
+    if (operations.size() + src_operations.size() >= FusedFloatMathFunction::max_operations) {
+      return this->add_input(field);
+    }
+    /* The inputs of a fused function are never fused functions themselves, unless the maximum
+     * number of operations was reached, so there is no need to recurse further. */
+    Vector<int, 4> src_args;
+    for (const fn::GField &src_input : operation->inputs()) {
+      src_args.append(this->add_input(src_input));
+    }
+    const int arg = this->append_operations(src_operations, src_args);
+    arg_by_inlined_node.add_new(&field.node(), arg);
+    inlined_any = true;
+    return arg;
+  }
+};
+
+}  // namespace
+
+std::optional<fn::GField> FusedFloatMathFunction::try_fuse_fields(
+    const Span<fn::GField> inputs) const
+{
+  BLI_assert(inputs.size() == inputs_num_);
+  FusionBuilder builder;
+  for (const fn::GField &input : inputs) {
+    builder.uses_by_node.add_or_modify(
+        &input.node(), [](int64_t *uses) { *uses = 1; }, [](int64_t *uses) { (*uses)++; });
+  }
+  Vector<int, 4> args;
+  for (const fn::GField &input : inputs) {
+    args.append(builder.add_field(input));
+  }
+  if (!builder.inlined_any) {
+    return std::nullopt;
+  }
+  builder.append_operations(operations_, args);
+  auto fn = std::make_shared<FusedFloatMathFunction>(builder.inputs.size(),
+                                                     std::move(builder.operations));
+  return fn::GField(fn::FieldOperation::Create(std::move(fn), std::move(builder.inputs)));
+}
+
+static void clamp_values(float *values, const int64_t n)
+{
+  for (int64_t i = 0; i < n; i++) {
+    values[i] = std::clamp(values[i], 0.0f, 1.0f);
+  }
+}
+
+void FusedFloatMathFunction::call(const IndexMask &mask,
+                                  mf::Params params,
+                                  mf::Context context) const
+{
+  if (base_fn_ != nullptr) {
+    base_fn_->call(mask, params, context);
+    if (operations_.first().clamp) {
+      /* This has actually been initialized in the call above. */
+      MutableSpan<float> results = params.uninitialized_single_output<float>(inputs_num_);
+      mask.foreach_index_optimized<int>(
+          [&](const int i) { results[i] = std::clamp(results[i], 0.0f, 1.0f); });
+    }
+    return;
+  }
+  MutableSpan<float> results = params.uninitialized_single_output<float>(inputs_num_);
+
+  /* Every input and every operation result has a buffer for the current block. */
+  const int operations_num = operations_.size();
+  Array<float, 8 * block_size> buffers((inputs_num_ + operations_num) * block_size);
+  auto buffer_for_input = [&](const int i) { return &buffers[i * block_size]; };
+  auto buffer_for_operation = [&](const int i) {
+    return &buffers[(inputs_num_ + i) * block_size];
+  };
+
+  /* Single values are filled into their buffer once, spans are used directly when possible. */
+  Array<VArraySpan<float>, 4> input_spans(inputs_num_);
+  Array<const float *, 4> input_block_data(inputs_num_);
+  for (const int i : IndexRange(inputs_num_)) {
+    const VArray<float> varray = params.readonly_single_input<float>(i);
+    if (const std::optional<float> value = varray.get_if_single()) {
+      std::fill_n(buffer_for_input(i), block_size, *value);
+      input_block_data[i] = buffer_for_input(i);
+    }
+    else {
+      input_spans[i] = VArraySpan<float>(varray);
+    }
+  }
+
+  std::array<const float *, 3> args;
+  mask.foreach_segment([&](const IndexMaskSegment segment) {
+    for (int64_t start = 0; start < segment.size(); start += block_size) {
+      const IndexMaskSegment block = segment.slice(
+          start, std::min<int64_t>(block_size, segment.size() - start));
+      const int64_t n = block.size();
+      const bool is_range = block.last() - block[0] + 1 == n;
+
+      for (const int i : IndexRange(inputs_num_)) {
+        const Span<float> span = input_spans[i];
+        if (span.is_empty()) {
+          continue;
+        }
+        if (is_range) {
+          input_block_data[i] = &span[block[0]];
+          continue;
+        }
+        float *buffer = buffer_for_input(i);
+        for (int64_t j = 0; j < n; j++) {
+          buffer[j] = span[block[j]];
+        }
+        input_block_data[i] = buffer;
+      }
+
+      for (const int op_i : operations_.index_range()) {
+        const Operation &op = operations_[op_i];
+        for (const int arg_i : IndexRange(op.args_num)) {
+          const int arg = op.args[arg_i];
+          args[arg_i] = arg < 0 ? input_block_data[-arg - 1] : buffer_for_operation(arg);
+        }
+        /* The last operation writes its result directly into the output when possible. */
+        const bool is_last = op_i == operations_num - 1;
+        float *r_values = (is_last && is_range) ? &results[block[0]] : buffer_for_operation(op_i);
+        op.kernel(args.data(), r_values, n);
+        if (op.clamp) {
+          clamp_values(r_values, n);
+        }
+      }
+
+      if (!is_range) {
+        const float *last_values = buffer_for_operation(operations_num - 1);
+        for (int64_t j = 0; j < n; j++) {
+          results[block[j]] = last_values[j];
+        }
+      }
+    }
+  });
+}
+
+}  // namespace blender::nodes
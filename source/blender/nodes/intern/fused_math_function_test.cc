@@ -0,0 +1,190 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "DNA_node_types.h"
+
+#include "FN_field.hh"
+#include "FN_multi_function_builder.hh"
+
+#include "NOD_fused_math_function.hh"
+#include "NOD_math_functions.hh"
+
+namespace blender::nodes::tests {
+
+class IndexFloatFieldInput final : public fn::FieldInput {
+ public:
+  IndexFloatFieldInput() : fn::FieldInput(CPPType::get<float>(), "Index") {}
+
+  GVArray get_varray_for_context(const fn::FieldContext & /*context*/,
+                                 const IndexMask &mask,
+                                 ResourceScope & /*scope*/) const final
+  {
+    return VArray<float>::ForFunc(mask.min_array_size(), [](const int i) { return float(i); });
+  }
+};
+
+static const mf::MultiFunction &get_base_fn(const int operation)
+{
+  const mf::MultiFunction *base_fn = nullptr;
+  try_dispatch_float_math_fl_fl_to_fl(
+      operation, [&](auto devi_fn, auto function, const FloatMathOperationInfo &info) {
+        static auto fn = mf::build::SI2_SO<float, float, float>(
+            info.title_case_name.c_str(), function, devi_fn);
+        base_fn = &fn;
+      });
+  BLI_assert(base_fn != nullptr);
+  return *base_fn;
+}
+
+/**
+ * Same as the evaluation of a Math node on fields in Geometry Nodes. The inputs are moved into the
+ * new field, so that they don't count as additional users.
+ */
+static fn::GField math_field(const int operation, const bool clamp, fn::GField a, fn::GField b)
+{
+  Vector<fn::GField> inputs;
+  inputs.append(std::move(a));
+  inputs.append(std::move(b));
+  auto math_fn = std::make_shared<FusedFloatMathFunction>(
+      get_base_fn(operation), operation, clamp);
+  if (std::optional<fn::GField> fused_field = math_fn->try_fuse_fields(inputs)) {
+    return std::move(*fused_field);
+  }
+  return fn::GField(fn::FieldOperation::Create(std::move(math_fn), std::move(inputs)));
+}
+
+static int fused_operations_num(const fn::GField &field)
+{
+  const auto &operation = dynamic_cast<const fn::FieldOperation &>(field.node());
+  const auto &fused_fn = dynamic_cast<const FusedFloatMathFunction &>(operation.multi_function());
+  return fused_fn.operations().size();
+}
+
+static Array<float> evaluate_field(const fn::GField &field, const IndexMask &mask)
+{
+  Array<float> result(mask.min_array_size(), -1.0f);
+  fn::FieldContext context;
+  fn::FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(field, result.as_mutable_span());
+  evaluator.evaluate();
+  return result;
+}
+
+TEST(fused_math_function, RangeMask)
+{
+  const fn::GField index_field{std::make_shared<IndexFloatFieldInput>()};
+  fn::GField field = math_field(NODE_MATH_ADD, false, index_field, fn::make_constant_field(1.0f));
+  field = math_field(NODE_MATH_MULTIPLY, false, std::move(field), index_field);
+  EXPECT_EQ(fused_operations_num(field), 2);
+
+  /* Not a multiple of the block size. */
+  const IndexMask mask(1000);
+  const Array<float> result = evaluate_field(field, mask);
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(result[i], (i + 1.0f) * i);
+  }
+}
+
+TEST(fused_math_function, NonRangeMask)
+{
+  const fn::GField index_field{std::make_shared<IndexFloatFieldInput>()};
+  fn::GField field = math_field(
+      NODE_MATH_SUBTRACT, false, index_field, fn::make_constant_field(3.0f));
+  field = math_field(NODE_MATH_MULTIPLY, false, std::move(field), fn::make_constant_field(2.0f));
+  EXPECT_EQ(fused_operations_num(field), 2);
+
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(2000), GrainSize(4096), memory, [](const int64_t i) { return i % 3 != 1; });
+  const Array<float> result = evaluate_field(field, mask);
+  for (const int i : result.index_range()) {
+    if (i % 3 == 1) {
+      EXPECT_EQ(result[i], -1.0f);
+    }
+    else {
+      EXPECT_EQ(result[i], (i - 3.0f) * 2.0f);
+    }
+  }
+}
+
+TEST(fused_math_function, SingleValueInputs)
+{
+  fn::GField field = math_field(
+      NODE_MATH_ADD, false, fn::make_constant_field(2.0f), fn::make_constant_field(3.0f));
+  field = math_field(NODE_MATH_POWER, false, std::move(field), fn::make_constant_field(2.0f));
+  EXPECT_EQ(fused_operations_num(field), 2);
+
+  const Array<float> result = evaluate_field(field, IndexMask(600));
+  for (const float value : result) {
+    EXPECT_EQ(value, 25.0f);
+  }
+}
+
+TEST(fused_math_function, Clamp)
+{
+  const fn::GField index_field{std::make_shared<IndexFloatFieldInput>()};
+  /* Only the result of the first operation is clamped. */
+  fn::GField field = math_field(
+      NODE_MATH_SUBTRACT, true, index_field, fn::make_constant_field(500.0f));
+  field = math_field(NODE_MATH_MULTIPLY, false, std::move(field), fn::make_constant_field(4.0f));
+  EXPECT_EQ(fused_operations_num(field), 2);
+
+  const Array<float> result = evaluate_field(field, IndexMask(1000));
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(result[i], i <= 500 ? 0.0f : 4.0f);
+  }
+
+  /* Clamping of the last operation. */
+  field = math_field(NODE_MATH_DIVIDE, true, std::move(field), fn::make_constant_field(8.0f));
+  const Array<float> result_clamped = evaluate_field(field, IndexMask(1000));
+  for (const int i : IndexRange(1000)) {
+    EXPECT_EQ(result_clamped[i], i <= 500 ? 0.0f : 0.5f);
+  }
+}
+
+TEST(fused_math_function, MaxOperations)
+{
+  const fn::GField index_field{std::make_shared<IndexFloatFieldInput>()};
+  fn::GField field = index_field;
+  for ([[maybe_unused]] const int i : IndexRange(100)) {
+    field = math_field(NODE_MATH_ADD, false, std::move(field), fn::make_constant_field(1.0f));
+    EXPECT_LE(fused_operations_num(field), FusedFloatMathFunction::max_operations);
+  }
+
+  const Array<float> result = evaluate_field(field, IndexMask(300));
+  for (const int i : IndexRange(300)) {
+    EXPECT_EQ(result[i], i + 100.0f);
+  }
+}
+
+TEST(fused_math_function, SharedInput)
+{
+  const fn::GField index_field{std::make_shared<IndexFloatFieldInput>()};
+  const fn::GField shared_field = math_field(
+      NODE_MATH_ADD, false, index_field, fn::make_constant_field(1.0f));
+
+  /* The input is used by another field, so it is not inlined. */
+  const fn::GField field = math_field(NODE_MATH_MULTIPLY, false, shared_field, index_field);
+  const fn::GField other_field = math_field(
+      NODE_MATH_MULTIPLY, false, shared_field, fn::make_constant_field(2.0f));
+  EXPECT_EQ(fused_operations_num(field), 1);
+  EXPECT_EQ(fused_operations_num(other_field), 1);
+
+  /* Using the same field for multiple inputs of one operation does not prevent inlining. */
+  fn::GField square_field = math_field(
+      NODE_MATH_ADD, false, index_field, fn::make_constant_field(1.0f));
+  fn::GField square_input = square_field;
+  square_field = math_field(
+      NODE_MATH_MULTIPLY, false, std::move(square_input), std::move(square_field));
+  EXPECT_EQ(fused_operations_num(square_field), 2);
+
+  const Array<float> result = evaluate_field(square_field, IndexMask(300));
+  for (const int i : IndexRange(300)) {
+    EXPECT_EQ(result[i], (i + 1.0f) * (i + 1.0f));
+  }
+}
+
+}  // namespace blender::nodes::tests
@@ -20,6 +20,9 @@
  * complexity. So far, this does not seem to be a performance issue.
  */
 
+#include "MEM_guardedalloc.h"
+
+#include "NOD_fused_math_function.hh"
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_multi_function.hh"
@@ -32,10 +35,16 @@
 #include "BLI_dot_export.hh"
 #include "BLI_hash.h"
 #include "BLI_hash_md5.hh"
+#include "BLI_hash_mm2a.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_map.hh"
+#include "BLI_memory_cache.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_stack.hh"
+#include "BLI_threads.h"
 
 #include "DNA_ID.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_anonymous_attribute_make.hh"
 #include "BKE_compute_contexts.hh"
@@ -57,7 +66,9 @@
 #include "GEO_join_geometries.hh"
 
 #include <fmt/format.h>
+#include <mutex>
 #include <sstream>
+#include <variant>
 
 namespace blender::nodes {
 
@@ -128,6 +139,302 @@ static void lazy_function_interface_from_node(const bNode &node,
   }
 }
 
+/**
+ * Identifies a geometry passed into a memoized node. Components are compared by identity and
+ * version, which changes when a component is modified in place. The weak users make sure that
+ * the address of a freed component is not reused while the key exists.
+ */
+struct MemoGeometryInput {
+  std::string name;
+  Vector<WeakImplicitSharingPtr, 2> components;
+  Vector<int64_t, 2> versions;
+
+  uint64_t hash() const
+  {
+    uint64_t hash = get_default_hash(this->name);
+    for (const int i : this->components.index_range()) {
+      hash = get_default_hash(hash, this->components[i], this->versions[i]);
+    }
+    return hash;
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_3(MemoGeometryInput, name, components, versions)
+};
+
+/** A single value passed into a memoized node, compared by value. */
+struct MemoSingleValueInput {
+  SocketValueVariant value;
+
+  uint64_t hash() const
+  {
+    const GPointer ptr = this->value.get_single_ptr();
+    return ptr.type()->hash(ptr.get());
+  }
+
+  friend bool operator==(const MemoSingleValueInput &a, const MemoSingleValueInput &b)
+  {
+    const GPointer a_ptr = a.value.get_single_ptr();
+    const GPointer b_ptr = b.value.get_single_ptr();
+    return a_ptr.type() == b_ptr.type() && a_ptr.type()->is_equal(a_ptr.get(), b_ptr.get());
+  }
+};
+
+struct MemoAttributeSetInput {
+  std::shared_ptr<Set<std::string>> names;
+
+  uint64_t hash() const
+  {
+    if (!this->names) {
+      return 0;
+    }
+    /* The hash must not depend on the order of the names in the set. */
+    uint64_t hash = 0;
+    for (const std::string &name : *this->names) {
+      hash += get_default_hash(name);
+    }
+    return hash;
+  }
+
+  friend bool operator==(const MemoAttributeSetInput &a, const MemoAttributeSetInput &b)
+  {
+    if (!a.names || !b.names) {
+      return a.names == b.names;
+    }
+    return *a.names == *b.names;
+  }
+};
+
+/**
+ * Fields are compared with #FieldNode::is_equal_to, so e.g. attribute inputs match even if they
+ * are recreated for every evaluation.
+ */
+using MemoInput =
+    std::variant<bool, MemoGeometryInput, MemoSingleValueInput, MemoAttributeSetInput, GField>;
+
+/**
+ * Nodes with #bNodeType::geometry_node_memoize store their outputs in the global memory cache,
+ * keyed by their settings and inputs. When such a node is evaluated again with the same inputs
+ * (e.g. because only a parameter of a node further downstream changed), the cached outputs are
+ * used instead of executing the node. Since cached geometries are passed on unchanged, memoized
+ * nodes depending on them are found in the cache as well.
+ */
+class GeometryNodeMemoKey : public GenericKey {
+ public:
+  const bke::bNodeType *node_type = nullptr;
+  int16_t custom1 = 0;
+  int16_t custom2 = 0;
+  float custom3 = 0.0f;
+  float custom4 = 0.0f;
+  Vector<uint8_t> storage;
+  /** Anonymous attribute names created by the node depend on these. */
+  std::string self_object_name;
+  ComputeContextHash compute_context_hash;
+  int32_t node_identifier = 0;
+  /** Which outputs the node computes depends on their usage. */
+  Vector<lf::ValueUsage> output_usages;
+  Vector<MemoInput> inputs;
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(this->node_type, this->custom1, this->custom2);
+    hash = get_default_hash(hash, this->custom3, this->custom4, this->node_identifier);
+    hash = get_default_hash(hash,
+                            BLI_hash_mm2(this->storage.data(), this->storage.size(), 0),
+                            this->self_object_name,
+                            this->compute_context_hash);
+    for (const lf::ValueUsage usage : this->output_usages) {
+      hash = get_default_hash(hash, usage);
+    }
+    for (const MemoInput &input : this->inputs) {
+      const uint64_t input_hash = std::visit(
+          [](const auto &value) { return get_default_hash(value); }, input);
+      hash = get_default_hash(hash, input.index(), input_hash);
+    }
+    return hash;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    const auto *other_typed = dynamic_cast<const GeometryNodeMemoKey *>(&other);
+    if (other_typed == nullptr) {
+      return false;
+    }
+    const GeometryNodeMemoKey &b = *other_typed;
+    return this->node_type == b.node_type && this->custom1 == b.custom1 &&
+           this->custom2 == b.custom2 && this->custom3 == b.custom3 &&
+           this->custom4 == b.custom4 && this->storage == b.storage &&
+           this->self_object_name == b.self_object_name &&
+           this->compute_context_hash == b.compute_context_hash &&
+           this->node_identifier == b.node_identifier && this->output_usages == b.output_usages &&
+           this->inputs == b.inputs;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<GeometryNodeMemoKey>(*this);
+  }
+};
+
+/** Number of points and instances in the geometry, used as a measure of its size in profiles. */
+static int64_t count_geometry_elements(const GeometrySet &geometry)
+{
+  int64_t count = 0;
+  for (const bke::GeometryComponent *component : geometry.get_components()) {
+    switch (component->type()) {
+      case bke::GeometryComponent::Type::Mesh:
+      case bke::GeometryComponent::Type::Curve:
+      case bke::GeometryComponent::Type::PointCloud:
+        count += component->attribute_domain_size(AttrDomain::Point);
+        break;
+      case bke::GeometryComponent::Type::Instance:
+        count += component->attribute_domain_size(AttrDomain::Instance);
+        break;
+      default:
+        break;
+    }
+  }
+  return count;
+}
+
+/** Outputs of a memoized node, indexed like the outputs of its lazy-function. */
+class GeometryNodeMemoValue : public memory_cache::CachedValue {
+ public:
+  Array<std::variant<std::monostate, GeometrySet, SocketValueVariant>> outputs;
+  /** Logged again whenever the outputs are reused. */
+  Vector<geo_eval_log::NodeWarning> warnings;
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    for (const geo_eval_log::NodeWarning &warning : this->warnings) {
+      memory.add(sizeof(warning) + warning.message.size());
+    }
+    for (const auto &output : this->outputs) {
+      if (const GeometrySet *geometry = std::get_if<GeometrySet>(&output)) {
+        geometry->count_memory(memory);
+      }
+      else if (std::holds_alternative<SocketValueVariant>(output)) {
+        memory.add(sizeof(SocketValueVariant));
+      }
+    }
+  }
+};
+
+/**
+ * Forwards everything to the #Params of the graph executor, but also passes every output value to
+ * a callback before it is passed on, so that a copy of it can be stored.
+ */
+class OutputRecordingParams final : public lf::Params {
+ private:
+  lf::Params &base_params_;
+  FunctionRef<void(int index, GPointer value)> record_fn_;
+
+ public:
+  OutputRecordingParams(const LazyFunction &fn,
+                        lf::Params &base_params,
+                        const FunctionRef<void(int index, GPointer value)> record_fn)
+      : lf::Params(fn, false), base_params_(base_params), record_fn_(record_fn)
+  {
+  }
+
+ private:
+  void *try_get_input_data_ptr_impl(const int index) const override
+  {
+    return base_params_.try_get_input_data_ptr(index);
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    return base_params_.try_get_input_data_ptr_or_request(index);
+  }
+
+  void *get_output_data_ptr_impl(const int index) override
+  {
+    return base_params_.get_output_data_ptr(index);
+  }
+
+  void output_set_impl(const int index) override
+  {
+    const void *data = base_params_.get_output_data_ptr(index);
+    record_fn_(index, {*fn_.outputs()[index].type, data});
+    base_params_.output_set(index);
+  }
+
+  bool output_was_set_impl(const int index) const override
+  {
+    return base_params_.output_was_set(index);
+  }
+
+  lf::ValueUsage get_output_usage_impl(const int index) const override
+  {
+    return base_params_.get_output_usage(index);
+  }
+
+  void set_input_unused_impl(const int index) override
+  {
+    base_params_.set_input_unused(index);
+  }
+
+  bool try_enable_multi_threading_impl() override
+  {
+    return base_params_.try_enable_multi_threading();
+  }
+};
+
+static bool is_memoizable_socket_type(const CPPType &type)
+{
+  return type.is<bool>() || type.is<GeometrySet>() || type.is<SocketValueVariant>() ||
+         type.is<bke::AnonymousAttributeSet>();
+}
+
+/**
+ * \return False if one of the inputs cannot be used as part of the key, e.g. volume grids or
+ * geometries referencing data that is not owned by them.
+ */
+static bool memo_input_from_value(const GPointer value, MemoInput &r_input)
+{
+  const CPPType &type = *value.type();
+  if (type.is<bool>()) {
+    r_input = *value.get<bool>();
+    return true;
+  }
+  if (type.is<GeometrySet>()) {
+    const GeometrySet &geometry = *value.get<GeometrySet>();
+    MemoGeometryInput input;
+    input.name = geometry.name;
+    for (const bke::GeometryComponent *component : geometry.get_components()) {
+      if (!component->owns_direct_data()) {
+        return false;
+      }
+      component->add_weak_user();
+      input.components.append(WeakImplicitSharingPtr(component));
+      input.versions.append(component->version());
+    }
+    r_input = std::move(input);
+    return true;
+  }
+  if (type.is<SocketValueVariant>()) {
+    const SocketValueVariant &value_variant = *value.get<SocketValueVariant>();
+    if (value_variant.is_single()) {
+      const CPPType &single_type = *value_variant.get_single_ptr().type();
+      if (!single_type.is_hashable() || !single_type.is_equality_comparable()) {
+        return false;
+      }
+      r_input = MemoSingleValueInput{value_variant};
+      return true;
+    }
+    if (value_variant.is_volume_grid()) {
+      return false;
+    }
+    r_input = value_variant.get<GField>();
+    return true;
+  }
+  if (type.is<bke::AnonymousAttributeSet>()) {
+    r_input = MemoAttributeSetInput{value.get<bke::AnonymousAttributeSet>()->names};
+    return true;
+  }
+  return false;
+}
+
 /**
  * Used for most normal geometry nodes like Subdivision Surface and Set Position.
  */
@@ -141,6 +448,8 @@ class LazyFunctionForGeometryNode : public LazyFunction {
    * does not have to execute.
    */
   Vector<bool> is_attribute_output_bsocket_;
+  /** True when the outputs of the node may be reused from the memory cache. */
+  bool use_memoization_ = false;
 
  public:
   LazyFunctionForGeometryNode(const bNode &node,
@@ -157,6 +466,7 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     const NodeDeclaration &node_decl = *node.declaration();
     const aal::RelationsInNode *relations = node_decl.anonymous_attribute_relations();
     if (relations == nullptr) {
+      this->init_memoization();
       return;
     }
     if (!relations->available_relations.is_empty()) {
@@ -192,6 +502,8 @@ class LazyFunctionForGeometryNode : public LazyFunction {
             [output_bsocket.index_in_all_outputs()] = lf_index;
       }
     }
+
+    this->init_memoization();
   }
 
   void execute_impl(lf::Params &params, const lf::Context &context) const override
@@ -239,6 +551,14 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     }
     if (missing_input) {
       /* Wait until all inputs are available. */
+      if (user_data->call_data->log_profile) {
+        if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+                *user_data))
+        {
+          tree_logger->node_input_requests.append(*tree_logger->allocator,
+                                                  {node_.identifier, geo_eval_log::Clock::now()});
+        }
+      }
       return;
     }
 
@@ -246,25 +566,102 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return this->anonymous_attribute_name_for_output(*user_data, i);
     };
 
-    GeoNodeExecParams geo_params{
-        node_,
-        params,
-        context,
-        own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
-        own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
-        get_anonymous_attribute_name};
+    auto execute_node = [&](lf::Params &exec_params,
+                            Vector<geo_eval_log::NodeWarning> *r_warnings) {
+      GeoNodeExecParams geo_params{
+          node_,
+          exec_params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
+          get_anonymous_attribute_name};
+      if (r_warnings) {
+        geo_params.record_warnings(*r_warnings);
+      }
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
 
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
-    node_.typeinfo->geometry_node_execute(geo_params);
+    std::optional<GeometryNodeMemoKey> memo_key;
+    if (use_memoization_ && !USER_EXPERIMENTAL_TEST(&U, no_geometry_nodes_memoization)) {
+      memo_key = this->try_build_memo_key(params, *user_data);
+    }
+    if (memo_key) {
+      bool executed = false;
+      const std::shared_ptr<const GeometryNodeMemoValue> memo_value =
+          memory_cache::get<GeometryNodeMemoValue>(*memo_key, [&]() {
+            auto value = std::make_unique<GeometryNodeMemoValue>();
+            value->outputs.reinitialize(outputs_.size());
+            OutputRecordingParams recording_params{
+                *this, params, [&](const int index, const GPointer output_value) {
+                  if (output_value.type()->is<GeometrySet>()) {
+                    value->outputs[index] = *output_value.get<GeometrySet>();
+                  }
+                  else {
+                    BLI_assert(output_value.type()->is<SocketValueVariant>());
+                    value->outputs[index] = *output_value.get<SocketValueVariant>();
+                  }
+                }};
+            execute_node(recording_params, &value->warnings);
+            executed = true;
+            return value;
+          });
+      if (!executed) {
+        this->set_outputs_from_memo(params, *memo_value);
+        if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+                *user_data))
+        {
+          for (const geo_eval_log::NodeWarning &warning : memo_value->warnings) {
+            tree_logger->node_warnings.append(
+                *tree_logger->allocator,
+                {node_.identifier,
+                 {warning.type, tree_logger->allocator->copy_string(warning.message)}});
+          }
+        }
+      }
+    }
+    else {
+      execute_node(params, nullptr);
+    }
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
 
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
     {
       tree_logger->node_execution_times.append(*tree_logger->allocator,
                                                {node_.identifier, start_time, end_time});
+      if (user_data->call_data->log_profile) {
+        this->log_output_profile(params, *tree_logger);
+      }
     }
   }
 
+  void log_output_profile(lf::Params &params, geo_eval_log::GeoTreeLogger &tree_logger) const
+  {
+    int64_t output_elements = 0;
+    MemoryCount memory;
+    MemoryCounter memory_counter{memory};
+    for (const int i : outputs_.index_range()) {
+      if (outputs_[i].type != &CPPType::get<GeometrySet>() || !params.output_was_set(i)) {
+        continue;
+      }
+      const GeometrySet &geometry = *static_cast<const GeometrySet *>(
+          params.get_output_data_ptr(i));
+      output_elements += count_geometry_elements(geometry);
+      geometry.count_memory(memory_counter);
+    }
+    tree_logger.node_profiles.append(*tree_logger.allocator,
+                                     {node_.identifier, output_elements, memory.total_bytes});
+  }
+
+  /**
+   * Nodes that output anonymous attributes use names that depend on the compute context, so their
+   * outputs are different in every context even if the inputs are the same.
+   */
+  bool has_anonymous_attribute_outputs() const
+  {
+    return is_attribute_output_bsocket_.contains(true);
+  }
+
   std::string input_name(const int index) const override
   {
     for (const bNodeSocket *bsocket : node_.output_sockets()) {
@@ -319,6 +716,75 @@ class LazyFunctionForGeometryNode : public LazyFunction {
                                                  node_.identifier,
                                                  node_.output_socket(output_index).identifier);
   }
+
+ private:
+  void init_memoization()
+  {
+    if (!node_.typeinfo->geometry_node_memoize) {
+      return;
+    }
+    for (const lf::Input &input : inputs_) {
+      if (!is_memoizable_socket_type(*input.type)) {
+        return;
+      }
+    }
+    for (const lf::Output &output : outputs_) {
+      if (!output.type->is<GeometrySet>() && !output.type->is<SocketValueVariant>()) {
+        return;
+      }
+    }
+    use_memoization_ = true;
+  }
+
+  /**
+   * Expects all inputs to be available already.
+   * \return Empty if one of the inputs cannot be used to identify the evaluation.
+   */
+  std::optional<GeometryNodeMemoKey> try_build_memo_key(lf::Params &params,
+                                                        const GeoNodesLFUserData &user_data) const
+  {
+    GeometryNodeMemoKey key;
+    for (const int lf_index : inputs_.index_range()) {
+      const GPointer value{*inputs_[lf_index].type, params.try_get_input_data_ptr(lf_index)};
+      MemoInput input;
+      if (!memo_input_from_value(value, input)) {
+        return std::nullopt;
+      }
+      key.inputs.append(std::move(input));
+    }
+    for (const int lf_index : outputs_.index_range()) {
+      key.output_usages.append(params.get_output_usage(lf_index));
+    }
+    key.node_type = node_.typeinfo;
+    key.custom1 = node_.custom1;
+    key.custom2 = node_.custom2;
+    key.custom3 = node_.custom3;
+    key.custom4 = node_.custom4;
+    if (node_.storage != nullptr) {
+      const uint8_t *storage = static_cast<const uint8_t *>(node_.storage);
+      key.storage.extend(Span(storage, MEM_allocN_len(node_.storage)));
+    }
+    key.self_object_name = user_data.call_data->self_object()->id.name;
+    key.compute_context_hash = user_data.compute_context->hash();
+    key.node_identifier = node_.identifier;
+    return key;
+  }
+
+  void set_outputs_from_memo(lf::Params &params, const GeometryNodeMemoValue &memo_value) const
+  {
+    for (const int lf_index : outputs_.index_range()) {
+      if (params.output_was_set(lf_index)) {
+        continue;
+      }
+      const auto &output = memo_value.outputs[lf_index];
+      if (const GeometrySet *geometry = std::get_if<GeometrySet>(&output)) {
+        params.set_output(lf_index, GeometrySet(*geometry));
+      }
+      else if (const SocketValueVariant *value = std::get_if<SocketValueVariant>(&output)) {
+        params.set_output(lf_index, SocketValueVariant(*value));
+      }
+    }
+  }
 };
 
 /**
@@ -510,6 +976,16 @@ static void execute_multi_function_on_value_variant__field(
     input_fields.append(input_values[i]->extract<GField>());
   }
 
+  if (const auto *math_fn = dynamic_cast<const FusedFloatMathFunction *>(&fn)) {
+    /* Merge chains of math nodes into a single field operation. */
+    if (std::optional<GField> fused_field = math_fn->try_fuse_fields(input_fields)) {
+      if (output_values[0] != nullptr) {
+        output_values[0]->set(std::move(*fused_field));
+      }
+      return;
+    }
+  }
+
   /* Construct the new field node. */
   std::shared_ptr<fn::FieldOperation> operation;
   if (owned_fn) {
@@ -1711,6 +2187,180 @@ static std::string zone_wrapper_output_name(const ZoneBuildInfo &zone_info,
   return outputs[lf_socket_i].debug_name;
 }
 
+/**
+ * Copies of the outputs of nodes in a repeat zone body that are the same in every iteration. The
+ * cache is shared by all iterations of one evaluation of the zone.
+ */
+struct RepeatZoneInvariantCache {
+  std::mutex mutex;
+  LinearAllocator<> allocator;
+  /** Output values of every node that has been executed already, null if not computed. */
+  Map<const lf::FunctionNode *, Array<void *>> values_by_node;
+
+  ~RepeatZoneInvariantCache()
+  {
+    for (const auto item : values_by_node.items()) {
+      const Span<lf::Output> outputs = item.key->function().outputs();
+      for (const int i : outputs.index_range()) {
+        if (item.value[i] != nullptr) {
+          outputs[i].type->destruct(item.value[i]);
+        }
+      }
+    }
+  }
+
+  void add(const lf::FunctionNode &node, const int index, const GPointer value)
+  {
+    std::lock_guard lock{this->mutex};
+    Array<void *> &values = values_by_node.lookup_or_add_cb(&node, [&]() {
+      return Array<void *>(node.function().outputs().size(), nullptr);
+    });
+    if (values[index] != nullptr) {
+      /* The value has been computed by another iteration in the mean-time. */
+      return;
+    }
+    const CPPType &type = *value.type();
+    void *buffer = allocator.allocate(type.size(), type.alignment());
+    type.copy_construct(value.get(), buffer);
+    values[index] = buffer;
+  }
+
+  /**
+   * \return True if all outputs that may still be used have been set from cached values. Otherwise
+   * no output is set.
+   */
+  bool try_set_outputs(const lf::FunctionNode &node, lf::Params &params)
+  {
+    const Span<lf::Output> outputs = node.function().outputs();
+    Array<const void *, 16> src_values(outputs.size(), nullptr);
+    {
+      std::lock_guard lock{this->mutex};
+      const Array<void *> *values = values_by_node.lookup_ptr(&node);
+      if (values == nullptr) {
+        return false;
+      }
+      for (const int i : outputs.index_range()) {
+        if (params.get_output_usage(i) == lf::ValueUsage::Unused || params.output_was_set(i)) {
+          continue;
+        }
+        if ((*values)[i] == nullptr) {
+          return false;
+        }
+        src_values[i] = (*values)[i];
+      }
+    }
+    /* Values are never removed from the cache while the zone is evaluated, so they can be copied
+     * without holding the lock. */
+    for (const int i : outputs.index_range()) {
+      if (src_values[i] != nullptr) {
+        outputs[i].type->copy_construct(src_values[i], params.get_output_data_ptr(i));
+        params.output_set(i);
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * Nodes whose outputs only depend on their inputs and not e.g. on the compute context or side
+ * effects.
+ */
+static bool is_context_independent_function(const LazyFunction &fn)
+{
+  if (const auto *geometry_node_fn = dynamic_cast<const LazyFunctionForGeometryNode *>(&fn)) {
+    return !geometry_node_fn->has_anonymous_attribute_outputs();
+  }
+  return dynamic_cast<const LazyFunctionForMultiFunctionNode *>(&fn) ||
+         dynamic_cast<const LazyFunctionForMultiFunctionConversion *>(&fn) ||
+         dynamic_cast<const LazyFunctionForMultiInput *>(&fn) ||
+         dynamic_cast<const LazyFunctionForRerouteNode *>(&fn) ||
+         dynamic_cast<const LazyFunctionForImplicitInput *>(&fn) ||
+         dynamic_cast<const LazyFunctionForLogicalOr *>(&fn) ||
+         dynamic_cast<const LazyFunctionForSwitchSocketUsage *>(&fn) ||
+         dynamic_cast<const LazyFunctionForIndexSwitchSocketUsage *>(&fn) ||
+         dynamic_cast<const LazyFunctionForAnonymousAttributeSetExtract *>(&fn) ||
+         dynamic_cast<const LazyFunctionForAnonymousAttributeSetJoin *>(&fn);
+}
+
+/**
+ * Find the nodes in the body of a repeat zone that compute the same values in every iteration,
+ * because they don't depend on the inputs that change between iterations. Only nodes that are
+ * potentially expensive are returned, cheap nodes are not worth caching.
+ */
+static Set<const lf::FunctionNode *> find_iteration_invariant_nodes(
+    const lf::Graph &graph, const Span<const lf::GraphInputSocket *> varying_inputs)
+{
+  Array<bool> is_varying(graph.nodes().size(), false);
+  Stack<const lf::Node *> nodes_to_check;
+  auto mark_varying = [&](const lf::Node &node) {
+    if (!is_varying[node.index_in_graph()]) {
+      is_varying[node.index_in_graph()] = true;
+      nodes_to_check.push(&node);
+    }
+  };
+  for (const lf::GraphInputSocket *input : varying_inputs) {
+    for (const lf::InputSocket *target : input->targets()) {
+      mark_varying(target->node());
+    }
+  }
+  for (const lf::FunctionNode *node : graph.function_nodes()) {
+    if (!is_context_independent_function(node->function())) {
+      mark_varying(*node);
+    }
+  }
+  while (!nodes_to_check.is_empty()) {
+    const lf::Node &node = *nodes_to_check.pop();
+    for (const lf::OutputSocket *output : node.outputs()) {
+      for (const lf::InputSocket *target : output->targets()) {
+        mark_varying(target->node());
+      }
+    }
+  }
+
+  Set<const lf::FunctionNode *> invariant_nodes;
+  for (const lf::FunctionNode *node : graph.function_nodes()) {
+    if (is_varying[node->index_in_graph()]) {
+      continue;
+    }
+    const LazyFunction &fn = node->function();
+    if (dynamic_cast<const LazyFunctionForGeometryNode *>(&fn) ||
+        dynamic_cast<const LazyFunctionForMultiFunctionNode *>(&fn))
+    {
+      invariant_nodes.add_new(node);
+    }
+  }
+  return invariant_nodes;
+}
+
+/**
+ * Executes the nodes found by #find_iteration_invariant_nodes only once per evaluation of a repeat
+ * zone. Later iterations get a copy of the cached outputs, so the invariant part of the loop body
+ * is effectively hoisted out of the loop.
+ */
+class RepeatBodyInvariantNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper {
+ public:
+  Set<const lf::FunctionNode *> invariant_nodes;
+
+  void execute_node(const lf::FunctionNode &node,
+                    lf::Params &params,
+                    const lf::Context &context) const override
+  {
+    const LazyFunction &fn = node.function();
+    const auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+    RepeatZoneInvariantCache *cache = user_data.repeat_zone_invariant_cache;
+    if (cache == nullptr || !invariant_nodes.contains(&node)) {
+      fn.execute(params, context);
+      return;
+    }
+    if (cache->try_set_outputs(node, params)) {
+      return;
+    }
+    OutputRecordingParams recording_params{
+        fn, params, [&](const int index, const GPointer value) { cache->add(node, index, value); }};
+    fn.execute(recording_params, context);
+  }
+};
+
 /**
  * Wraps the execution of a repeat loop body. The purpose is to setup the correct #ComputeContext
  * inside of the loop body. This is necessary to support correct logging inside of a repeat zone.
@@ -1721,6 +2371,7 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
  public:
   const bNode *repeat_output_bnode_ = nullptr;
   VectorSet<lf::FunctionNode *> *lf_body_nodes_ = nullptr;
+  RepeatZoneInvariantCache *invariant_cache_ = nullptr;
 
   void execute_node(const lf::FunctionNode &node,
                     lf::Params &params,
@@ -1742,6 +2393,7 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
     body_user_data.compute_context = &body_compute_context;
     body_user_data.log_socket_values = should_log_socket_values_for_context(
         user_data, body_compute_context.hash());
+    body_user_data.repeat_zone_invariant_cache = invariant_cache_;
 
     GeoNodesLFLocalUserData body_local_user_data{body_user_data};
     lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
@@ -1789,6 +2441,7 @@ struct RepeatEvalStorage {
   std::optional<LazyFunctionForLogicalOr> or_function;
   std::optional<RepeatZoneSideEffectProvider> side_effect_provider;
   std::optional<RepeatBodyNodeExecuteWrapper> body_execute_wrapper;
+  RepeatZoneInvariantCache invariant_cache;
   std::optional<lf::GraphExecutor> graph_executor;
   Array<SocketValueVariant> index_values;
   void *graph_executor_storage = nullptr;
@@ -2073,6 +2726,7 @@ class LazyFunctionForRepeatZone : public LazyFunction {
     eval_storage.body_execute_wrapper.emplace();
     eval_storage.body_execute_wrapper->repeat_output_bnode_ = &repeat_output_bnode_;
     eval_storage.body_execute_wrapper->lf_body_nodes_ = &lf_body_nodes;
+    eval_storage.body_execute_wrapper->invariant_cache_ = &eval_storage.invariant_cache;
     eval_storage.side_effect_provider.emplace();
     eval_storage.side_effect_provider->repeat_output_bnode_ = &repeat_output_bnode_;
     eval_storage.side_effect_provider->lf_body_nodes_ = lf_body_nodes;
@@ -2482,6 +3136,12 @@ class LazyFunctionForForeachGeometryElementZone : public LazyFunction {
                                         nullptr,
                                         &*eval_storage.side_effect_provider,
                                         &*eval_storage.body_execute_wrapper);
+    /* The iterations are independent of each other, so distribute them to other threads in
+     * batches right away, instead of waiting for very many iterations to be scheduled or for a
+     * node in one iteration to indicate that it takes a while. The batches are split until there
+     * are a few per thread for load balancing. */
+    eval_storage.graph_executor->set_parallel_batch_threshold(
+        std::max(2, eval_storage.total_iterations_num / (4 * BLI_system_thread_count())));
     eval_storage.graph_executor_storage = eval_storage.graph_executor->init_storage(
         eval_storage.allocator);
 
@@ -3916,12 +4576,31 @@ struct GeometryNodesLazyFunctionBuilder {
     auto &logger = scope_.construct<GeometryNodesLazyFunctionLogger>(*lf_graph_info_);
     auto &side_effect_provider = scope_.construct<GeometryNodesLazyFunctionSideEffectProvider>();
 
+    /* Nodes in a repeat zone that don't depend on the current iteration only have to be executed
+     * once per evaluation of the zone. */
+    RepeatBodyInvariantNodeExecuteWrapper *invariant_execute_wrapper = nullptr;
+    if (zone.output_node->type == GEO_NODE_REPEAT_OUTPUT) {
+      Vector<const lf::GraphInputSocket *> lf_varying_inputs;
+      for (const int i : body_fn.indices.inputs.main) {
+        lf_varying_inputs.append(lf_body_inputs[i]);
+      }
+      for (const int i : body_fn.indices.inputs.output_usages) {
+        lf_varying_inputs.append(lf_body_inputs[i]);
+      }
+      Set<const lf::FunctionNode *> invariant_nodes = find_iteration_invariant_nodes(
+          lf_body_graph, lf_varying_inputs);
+      if (!invariant_nodes.is_empty()) {
+        invariant_execute_wrapper = &scope_.construct<RepeatBodyInvariantNodeExecuteWrapper>();
+        invariant_execute_wrapper->invariant_nodes = std::move(invariant_nodes);
+      }
+    }
+
     body_fn.function = &scope_.construct<lf::GraphExecutor>(lf_body_graph,
                                                             lf_body_inputs.as_span(),
                                                             lf_body_outputs.as_span(),
                                                             &logger,
                                                             &side_effect_provider,
-                                                            nullptr);
+                                                            invariant_execute_wrapper);
 
     lf_graph_info_->debug_zone_body_graphs.add(zone.output_node->identifier, &lf_body_graph);
 
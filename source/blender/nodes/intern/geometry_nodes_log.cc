@@ -345,7 +345,9 @@ void GeoTreeLog::ensure_execution_times()
   for (GeoTreeLogger *tree_logger : tree_loggers_) {
     for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
       const std::chrono::nanoseconds duration = timings.end - timings.start;
-      this->nodes.lookup_or_add_default_as(timings.node_id).execution_time += duration;
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(timings.node_id);
+      node_log.execution_time += duration;
+      node_log.executions_num++;
     }
     this->execution_time += tree_logger->execution_time;
   }
@@ -364,6 +366,57 @@ void GeoTreeLog::ensure_execution_times()
   reduced_execution_times_ = true;
 }
 
+void GeoTreeLog::ensure_node_profiles()
+{
+  if (reduced_node_profiles_) {
+    return;
+  }
+  this->ensure_execution_times();
+  /* Nodes may be requested and executed on different threads, so use the earliest times. */
+  Map<int32_t, TimePoint> first_request_times;
+  Map<int32_t, TimePoint> first_start_times;
+  for (GeoTreeLogger *tree_logger : tree_loggers_) {
+    for (const GeoTreeLogger::NodeInputRequest &request : tree_logger->node_input_requests) {
+      first_request_times.add_or_modify(
+          request.node_id,
+          [&](TimePoint *time) { *time = request.time; },
+          [&](TimePoint *time) { *time = std::min(*time, request.time); });
+    }
+    for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
+      first_start_times.add_or_modify(
+          timings.node_id,
+          [&](TimePoint *time) { *time = timings.start; },
+          [&](TimePoint *time) { *time = std::min(*time, timings.start); });
+    }
+    for (const GeoTreeLogger::NodeProfile &profile : tree_logger->node_profiles) {
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(profile.node_id);
+      node_log.output_elements = std::max(node_log.output_elements, profile.output_elements);
+      node_log.output_bytes = std::max(node_log.output_bytes, profile.output_bytes);
+    }
+  }
+  for (const auto item : first_start_times.items()) {
+    if (const TimePoint *request_time = first_request_times.lookup_ptr(item.key)) {
+      if (*request_time < item.value) {
+        this->nodes.lookup(item.key).input_wait_time = item.value - *request_time;
+      }
+    }
+  }
+  reduced_node_profiles_ = true;
+}
+
+std::optional<int32_t> GeoTreeLog::parent_node_id() const
+{
+  if (tree_loggers_.is_empty()) {
+    return std::nullopt;
+  }
+  return tree_loggers_[0]->parent_node_id;
+}
+
+Span<ComputeContextHash> GeoTreeLog::children_hashes() const
+{
+  return children_hashes_;
+}
+
 void GeoTreeLog::ensure_socket_values()
 {
   if (reduced_socket_values_) {
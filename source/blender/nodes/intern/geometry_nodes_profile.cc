@@ -0,0 +1,263 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <iomanip>
+#include <mutex>
+
+#include "BLI_fileops.hh"
+#include "BLI_map.hh"
+#include "BLI_serialize.hh"
+#include "BLI_set.hh"
+#include "BLI_string.h"
+
+#include "BKE_global.hh"
+#include "BKE_node_runtime.hh"
+#include "BKE_node_tree_zones.hh"
+
+#include "NOD_geometry_nodes_log.hh"
+#include "NOD_geometry_nodes_profile.hh"
+
+namespace blender::nodes::geo_eval_log {
+
+/** Statistics of a node, or of a node tree when #node_name is empty. */
+struct ProfileStats {
+  std::string tree_name;
+  std::string node_name;
+  std::string node_idname;
+  int64_t executions_num = 0;
+  std::chrono::nanoseconds time{0};
+  std::chrono::nanoseconds input_wait_time{0};
+  int64_t max_output_elements = 0;
+  int64_t peak_output_bytes = 0;
+  /** Time spent in all nodes of a tree, larger than #time when nodes are evaluated in parallel. */
+  std::chrono::nanoseconds busy_time{0};
+};
+
+struct Profile {
+  std::mutex mutex;
+  /** Statistics are aggregated by the names of the tree and the node. */
+  Map<std::pair<std::string, std::string>, ProfileStats> stats;
+  Set<float> frames;
+};
+
+static Profile &get_profile()
+{
+  static Profile profile;
+  return profile;
+}
+
+bool profile_is_enabled()
+{
+  return G.filepath_geometry_nodes_profile[0] != '\0';
+}
+
+static ProfileStats &ensure_stats(Profile &profile, const bNodeTree &tree, const bNode *node)
+{
+  const StringRefNull tree_name = tree.id.name + 2;
+  const StringRefNull node_name = node ? node->name : "";
+  return profile.stats.lookup_or_add_cb({tree_name, node_name}, [&]() {
+    ProfileStats stats;
+    stats.tree_name = tree_name;
+    stats.node_name = node_name;
+    stats.node_idname = node ? node->idname : "";
+    return stats;
+  });
+}
+
+/**
+ * \param is_zone: The log belongs to a zone, whose time is part of the time of the tree already.
+ */
+static void add_tree_log(Profile &profile,
+                         GeoModifierLog &modifier_log,
+                         GeoTreeLog &tree_log,
+                         const bNodeTree &tree,
+                         const bool is_zone)
+{
+  tree_log.ensure_node_profiles();
+
+  ProfileStats &tree_stats = ensure_stats(profile, tree, nullptr);
+  if (!is_zone) {
+    tree_stats.executions_num++;
+    tree_stats.time += tree_log.execution_time;
+  }
+
+  for (const auto item : tree_log.nodes.items()) {
+    const bNode *node = tree.node_by_id(item.key);
+    if (node == nullptr) {
+      continue;
+    }
+    const GeoNodeLog &node_log = item.value;
+    ProfileStats &stats = ensure_stats(profile, tree, node);
+    stats.executions_num += node_log.executions_num;
+    stats.time += node_log.execution_time;
+    stats.input_wait_time += node_log.input_wait_time;
+    stats.max_output_elements = std::max(stats.max_output_elements, node_log.output_elements);
+    stats.peak_output_bytes = std::max(stats.peak_output_bytes, node_log.output_bytes);
+    if (!is_zone) {
+      tree_stats.busy_time += node_log.execution_time;
+    }
+  }
+
+  for (const ComputeContextHash &child_hash : tree_log.children_hashes()) {
+    GeoTreeLog &child_log = modifier_log.get_tree_log(child_hash);
+    const std::optional<int32_t> parent_node_id = child_log.parent_node_id();
+    if (!parent_node_id) {
+      continue;
+    }
+    const bNode *node = tree.node_by_id(*parent_node_id);
+    if (node == nullptr) {
+      continue;
+    }
+    if (node->is_group() && node->id) {
+      add_tree_log(profile,
+                   modifier_log,
+                   child_log,
+                   *reinterpret_cast<const bNodeTree *>(node->id),
+                   false);
+    }
+    else if (bke::all_zone_output_node_types().contains(node->type)) {
+      add_tree_log(profile, modifier_log, child_log, tree, true);
+    }
+  }
+}
+
+void profile_add_evaluation(GeoModifierLog &log,
+                            const ComputeContextHash &root_context_hash,
+                            const bNodeTree &tree,
+                            const float frame)
+{
+  Profile &profile = get_profile();
+  std::lock_guard lock{profile.mutex};
+  profile.frames.add(frame);
+  add_tree_log(profile, log, log.get_tree_log(root_context_hash), tree, false);
+}
+
+static double to_milliseconds(const std::chrono::nanoseconds time)
+{
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+
+/** Average number of nodes that were executed at the same time while evaluating a tree. */
+static double thread_utilization(const ProfileStats &stats)
+{
+  if (stats.node_name.empty() && stats.time.count() > 0) {
+    return double(stats.busy_time.count()) / double(stats.time.count());
+  }
+  return 0.0;
+}
+
+static void write_csv_string(std::ostream &stream, const StringRef str)
+{
+  stream << '"';
+  for (const char c : str) {
+    if (c == '"') {
+      stream << '"';
+    }
+    stream << c;
+  }
+  stream << '"';
+}
+
+static void write_csv(std::ostream &stream,
+                      const Span<const ProfileStats *> all_stats,
+                      const int frames_num)
+{
+  stream << "tree,node,type,executions,time_ms,time_per_frame_ms,input_wait_ms,"
+            "thread_utilization,max_output_elements,peak_output_bytes\n";
+  stream << std::fixed << std::setprecision(3);
+  for (const ProfileStats *stats : all_stats) {
+    write_csv_string(stream, stats->tree_name);
+    stream << ',';
+    write_csv_string(stream, stats->node_name);
+    stream << ',';
+    write_csv_string(stream, stats->node_idname);
+    stream << ',' << stats->executions_num << ',' << to_milliseconds(stats->time) << ','
+           << to_milliseconds(stats->time) / frames_num << ','
+           << to_milliseconds(stats->input_wait_time) << ',' << thread_utilization(*stats) << ','
+           << stats->max_output_elements << ',' << stats->peak_output_bytes << '\n';
+  }
+}
+
+static void write_json(std::ostream &stream,
+                       const Span<const ProfileStats *> all_stats,
+                       const int frames_num)
+{
+  using namespace io::serialize;
+  DictionaryValue root;
+  root.append_int("frames", frames_num);
+  ArrayValue &io_trees = *root.append_array("trees");
+  /* Tree statistics come first, so the dictionary of each tree is created before its nodes. */
+  Map<StringRef, ArrayValue *> io_nodes_by_tree;
+  for (const ProfileStats *stats : all_stats) {
+    DictionaryValue *io_stats;
+    if (stats->node_name.empty()) {
+      io_stats = io_trees.append_dict().get();
+      io_stats->append_str("name", stats->tree_name);
+      io_nodes_by_tree.add(stats->tree_name, io_stats->append_array("nodes").get());
+    }
+    else {
+      io_stats = io_nodes_by_tree.lookup(stats->tree_name)->append_dict().get();
+      io_stats->append_str("name", stats->node_name);
+      io_stats->append_str("type", stats->node_idname);
+    }
+    io_stats->append_int("executions", stats->executions_num);
+    io_stats->append_double("time_ms", to_milliseconds(stats->time));
+    io_stats->append_double("time_per_frame_ms", to_milliseconds(stats->time) / frames_num);
+    if (stats->node_name.empty()) {
+      io_stats->append_double("thread_utilization", thread_utilization(*stats));
+    }
+    else {
+      io_stats->append_double("input_wait_ms", to_milliseconds(stats->input_wait_time));
+      io_stats->append_int("max_output_elements", stats->max_output_elements);
+      io_stats->append_int("peak_output_bytes", stats->peak_output_bytes);
+    }
+  }
+  JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(stream, root);
+}
+
+void profile_write()
+{
+  if (!profile_is_enabled()) {
+    return;
+  }
+  Profile &profile = get_profile();
+  std::lock_guard lock{profile.mutex};
+
+  /* Sort by tree and put the most expensive nodes first. Tree statistics come before their nodes
+   * because their time includes the time of all nodes. */
+  Vector<const ProfileStats *> all_stats;
+  for (const ProfileStats &stats : profile.stats.values()) {
+    all_stats.append(&stats);
+  }
+  std::sort(all_stats.begin(), all_stats.end(), [](const ProfileStats *a, const ProfileStats *b) {
+    if (a->tree_name != b->tree_name) {
+      return a->tree_name < b->tree_name;
+    }
+    if (a->node_name.empty() != b->node_name.empty()) {
+      return a->node_name.empty();
+    }
+    return a->time > b->time;
+  });
+  const int frames_num = std::max<int>(profile.frames.size(), 1);
+
+  const char *filepath = G.filepath_geometry_nodes_profile;
+  fstream stream(filepath, std::ios::out);
+  if (!stream.is_open()) {
+    fprintf(stderr, "Error: Could not write geometry nodes profile to '%s'\n", filepath);
+    return;
+  }
+  if (BLI_str_endswith(filepath, ".json")) {
+    write_json(stream, all_stats, frames_num);
+  }
+  else {
+    write_csv(stream, all_stats, frames_num);
+  }
+  if (!G.quiet) {
+    printf("Geometry nodes profile written to '%s'\n", filepath);
+  }
+}
+
+}  // namespace blender::nodes::geo_eval_log
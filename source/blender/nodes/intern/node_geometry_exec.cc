@@ -34,6 +34,9 @@ void GeoNodeExecParams::error_message_add(const NodeWarningType type,
         *tree_logger->allocator,
         {node_.identifier, {type, tree_logger->allocator->copy_string(message)}});
   }
+  if (r_warnings_) {
+    r_warnings_->append({type, message});
+  }
 }
 
 void GeoNodeExecParams::used_named_attribute(const StringRef attribute_name,
@@ -9,6 +9,7 @@
 #include "node_shader_util.hh"
 #include "node_util.hh"
 
+#include "NOD_fused_math_function.hh"
 #include "NOD_inverse_eval_params.hh"
 #include "NOD_math_functions.hh"
 #include "NOD_multi_function.hh"
@@ -141,43 +142,16 @@ static const mf::MultiFunction *get_base_multi_function(const bNode &node)
   return nullptr;
 }
 
-class ClampWrapperFunction : public mf::MultiFunction {
- private:
-  const mf::MultiFunction &fn_;
-
- public:
-  ClampWrapperFunction(const mf::MultiFunction &fn) : fn_(fn)
-  {
-    this->set_signature(&fn.signature());
-  }
-
-  void call(const IndexMask &mask, mf::Params params, mf::Context context) const override
-  {
-    fn_.call(mask, params, context);
-
-    /* Assumes the output parameter is the last one. */
-    const int output_param_index = this->param_amount() - 1;
-    /* This has actually been initialized in the call above. */
-    MutableSpan<float> results = params.uninitialized_single_output<float>(output_param_index);
-
-    mask.foreach_index_optimized<int>([&](const int i) {
-      float &value = results[i];
-      CLAMP(value, 0.0f, 1.0f);
-    });
-  }
-};
-
 static void sh_node_math_build_multi_function(NodeMultiFunctionBuilder &builder)
 {
   const mf::MultiFunction *base_function = get_base_multi_function(builder.node());
-
-  const bool clamp_output = builder.node().custom2 != 0;
-  if (clamp_output) {
-    builder.construct_and_set_matching_fn<ClampWrapperFunction>(*base_function);
-  }
-  else {
-    builder.set_matching_fn(base_function);
+  if (base_function == nullptr) {
+    return;
   }
+  const int mode = builder.node().custom1;
+  const bool clamp_output = builder.node().custom2 != 0;
+  builder.construct_and_set_matching_fn<FusedFloatMathFunction>(
+      *base_function, mode, clamp_output);
 }
 
 static void node_eval_elem(value_elem::ElemEvalParams &params)
@@ -470,6 +470,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_set,
      bpy_app_debug_doc,
      (void *)G_DEBUG_DEPSGRAPH_TIME},
+    {"debug_depsgraph_memory",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DEPSGRAPH_MEMORY},
     {"debug_depsgraph_pretty",
      bpy_app_debug_get,
      bpy_app_debug_set,
@@ -29,6 +29,7 @@
 #include "BKE_report.hh"
 
 #include "DNA_space_types.h" /* FILE_LINK, FILE_RELPATH */
+#include "DNA_userdef_types.h"
 
 #include "BLO_readfile.hh"
 
@@ -279,14 +280,17 @@ static PyObject *bpy_lib_load(BPy_PropertyRNA *self, PyObject *args, PyObject *k
   return (PyObject *)ret;
 }
 
-static PyObject *_bpy_names(BPy_Library *self, int blocktype)
+static PyObject *_bpy_names(BPy_Library *self, const BlendFileIndex *blo_index, int blocktype)
 {
   PyObject *list;
   LinkNode *l, *names;
   int totnames;
 
-  names = BLO_blendhandle_get_datablock_names(
-      self->blo_handle, blocktype, (self->flag & FILE_ASSETS_ONLY) != 0, &totnames);
+  const bool use_assets_only = (self->flag & FILE_ASSETS_ONLY) != 0;
+  names = blo_index ? BLO_blendfile_index_get_datablock_names(
+                          blo_index, blocktype, use_assets_only, &totnames) :
+                      BLO_blendhandle_get_datablock_names(
+                          self->blo_handle, blocktype, use_assets_only, &totnames);
   list = PyList_New(totnames);
 
   if (names) {
@@ -313,9 +317,17 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
   memset(bf_reports, 0, sizeof(*bf_reports));
   bf_reports->reports = reports;
 
-  self->blo_handle = BLO_blendhandle_from_file(self->abspath, bf_reports);
+  BlendFileIndex *blo_index = nullptr;
+  if (USER_EXPERIMENTAL_TEST(&U, use_blend_file_index)) {
+    /* Only the names are needed here, the file is opened when linking if anything is requested.
+     * This avoids reading the file at all when its index is up to date. */
+    blo_index = BLO_blendfile_index_ensure(self->abspath, bf_reports);
+  }
+  else {
+    self->blo_handle = BLO_blendhandle_from_file(self->abspath, bf_reports);
+  }
 
-  if (self->blo_handle == nullptr) {
+  if (self->blo_handle == nullptr && blo_index == nullptr) {
     if (BPy_reports_to_error(reports, PyExc_IOError, true) != -1) {
       PyErr_Format(PyExc_IOError, "load: %s failed to open blend file", self->abspath);
     }
@@ -331,13 +343,17 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
 
       PyDict_SetItem(self->dict, str, item = PyList_New(0));
       Py_DECREF(item);
-      PyDict_SetItem(from_dict, str, item = _bpy_names(self, code));
+      PyDict_SetItem(from_dict, str, item = _bpy_names(self, blo_index, code));
       Py_DECREF(item);
 
       Py_DECREF(str);
     }
   }
 
+  if (blo_index) {
+    BLO_blendfile_index_free(blo_index);
+  }
+
   /* create a dummy */
   self_from = PyObject_New(BPy_Library, &bpy_lib_Type);
   STRNCPY(self_from->relpath, self->relpath);
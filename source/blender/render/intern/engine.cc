@@ -641,8 +641,15 @@ static bool engine_keep_depsgraph(RenderEngine *engine)
   /* For persistent data or GPU engines like Eevee, reuse the depsgraph between
    * view layers and animation frames. For renderers like Cycles that create
    * their own copy of the scene, persistent data must be explicitly enabled to
-   * keep memory usage low by default. */
-  return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
+   * keep memory usage low by default.
+   * With persistent depsgraph, animation renders keep the evaluated scene between frames, so that
+   * only time dependent operations are evaluated again, like in the viewport. The engine frees its
+   * own data as usual when persistent data is disabled. */
+  const Render *re = engine->re;
+  if ((re->r.mode & R_PERSISTENT_DEPSGRAPH) && (re->flag & R_ANIMATION)) {
+    return true;
+  }
+  return (re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
 }
 
 /* Depsgraph */
@@ -700,6 +707,12 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
   else {
     /* Go through update with full Python callbacks for regular render. */
     BKE_scene_graph_update_for_newframe_ex(engine->depsgraph, false);
+
+    /* Summary of the evaluated data before the engine syncs it, since engines may free the
+     * dependency graph before the render is done. */
+    if (DEG_debug_flags_get(engine->depsgraph) & G_DEBUG_DEPSGRAPH_MEMORY) {
+      DEG_debug_print_evaluated_memory(engine->depsgraph, 10);
+    }
   }
 
   engine->has_grease_pencil = DRW_render_check_grease_pencil(engine->depsgraph);
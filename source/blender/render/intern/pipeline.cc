@@ -757,6 +757,22 @@ static void re_free_persistent_data(Render *re)
   }
 }
 
+/**
+ * The persistent depsgraph only keeps the engine and its evaluated scene between the frames of an
+ * animation render, free them once it is done unless they are kept for other reasons.
+ */
+static void re_free_animation_persistent_depsgraph(Render *re)
+{
+  const RenderEngine *engine = re->engine;
+  if (engine == nullptr || !(re->r.mode & R_PERSISTENT_DEPSGRAPH)) {
+    return;
+  }
+  if ((re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT)) {
+    return;
+  }
+  re_free_persistent_data(re);
+}
+
 void RE_FreePersistentData(const Scene *scene)
 {
   /* Render engines can be kept around for quick re-render, this clears all or one scene. */
@@ -2622,6 +2638,7 @@ void RE_RenderAnim(Render *re,
                           G.is_break ? BKE_CB_EVT_RENDER_CANCEL : BKE_CB_EVT_RENDER_COMPLETE);
   BKE_sound_reset_scene_specs(re->pipeline_scene_eval);
 
+  re_free_animation_persistent_depsgraph(re);
   render_pipeline_free(re);
 
   /* UGLY WARNING */
@@ -913,6 +913,29 @@ static void wm_read_callback_post_wrapper(bContext *C, const char *filepath, con
 /** \name Read Main Blend-File API
  * \{ */
 
+/** Print #BlendFileReadReport.phases, in a format easy to parse by benchmark scripts. */
+static void file_read_reports_phases_print(const BlendFileReadReport *bf_reports)
+{
+  const BlendFileReadPhases &phases = bf_reports->phases;
+  const std::pair<const char *, const BlendFileReadPhaseStats *> phase_items[] = {
+      {"header_dna", &phases.header_dna},
+      {"bhead_scan", &phases.bhead_scan},
+      {"read_data", &phases.read_data},
+      {"read_struct", &phases.read_struct},
+      {"versioning", &phases.versioning},
+      {"lib_link", &phases.lib_link},
+      {"after_liblink", &phases.after_liblink},
+  };
+  for (const auto &[name, stats] : phase_items) {
+    printf("Blend-file read phase %s: %.6fs, %llu bytes read, %lld bytes allocated, %lld blocks\n",
+           name,
+           stats->duration,
+           (unsigned long long)stats->bytes_read,
+           (long long)stats->memory,
+           (long long)stats->memory_blocks);
+  }
+}
+
 static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
 {
   double duration_whole_minutes, duration_whole_seconds;
@@ -975,6 +998,10 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
             duration_lib_override_recursive_resync_minutes,
             duration_lib_override_recursive_resync_seconds);
 
+  if (G.debug & G_DEBUG_IO) {
+    file_read_reports_phases_print(bf_reports);
+  }
+
   if (bf_reports->resynced_lib_overrides_libraries_count != 0) {
     for (LinkNode *node_lib = bf_reports->resynced_lib_overrides_libraries; node_lib != nullptr;
          node_lib = node_lib->next)
@@ -2120,6 +2147,7 @@ static bool wm_file_write(bContext *C,
                           int fileflags,
                           eBLO_WritePathRemap remap_mode,
                           bool use_save_as_copy,
+                          const char *chunk_store_dirpath,
                           ReportList *reports)
 {
   Main *bmain = CTX_data_main(C);
@@ -2220,6 +2248,7 @@ static bool wm_file_write(bContext *C,
   blend_write_params.use_save_versions = true;
   blend_write_params.use_save_as_copy = use_save_as_copy;
   blend_write_params.thumb = thumb;
+  blend_write_params.chunk_store_dirpath = chunk_store_dirpath;
 
   const bool success = BLO_write_file(bmain, filepath, fileflags, &blend_write_params, reports);
 
@@ -3698,8 +3727,11 @@ static int wm_save_as_mainfile_exec(bContext *C, wmOperator *op)
   /* Set compression flag. */
   SET_FLAG_FROM_TEST(fileflags, RNA_boolean_get(op->ptr, "compress"), G_FILE_COMPRESS);
 
+  char chunk_store_dirpath[FILE_MAX];
+  RNA_string_get(op->ptr, "chunk_store_directory", chunk_store_dirpath);
+
   const bool success = wm_file_write(
-      C, filepath, fileflags, remap_mode, use_save_as_copy, op->reports);
+      C, filepath, fileflags, remap_mode, use_save_as_copy, chunk_store_dirpath, op->reports);
 
   if ((op->flag & OP_IS_INVOKE) == 0) {
     /* OP_IS_INVOKE is set when the operator is called from the GUI.
@@ -3751,6 +3783,20 @@ static bool wm_save_mainfile_check(bContext * /*C*/, wmOperator *op)
   return false;
 }
 
+static void wm_save_mainfile_chunk_store_property(wmOperatorType *ot)
+{
+  PropertyRNA *prop = RNA_def_string_dir_path(
+      ot->srna,
+      "chunk_store_directory",
+      nullptr,
+      FILE_MAX,
+      "Chunk Store Directory",
+      "Store large data arrays in this directory instead of in the file, so that they can be "
+      "shared by successive saves and other files using the same directory. The file can't be "
+      "opened without this directory");
+  RNA_def_property_flag(prop, PROP_SKIP_SAVE);
+}
+
 static std::string wm_save_as_mainfile_get_name(wmOperatorType *ot, PointerRNA *ptr)
 {
   if (RNA_boolean_get(ptr, "copy")) {
@@ -3805,6 +3851,7 @@ void WM_OT_save_as_mainfile(wmOperatorType *ot)
       "Save Copy",
       "Save a copy of the actual working state but does not make saved file active");
   RNA_def_property_flag(prop, PROP_SKIP_SAVE);
+  wm_save_mainfile_chunk_store_property(ot);
 }
 
 static int wm_save_mainfile_invoke(bContext *C, wmOperator *op, const wmEvent * /*event*/)
@@ -3896,6 +3943,8 @@ void WM_OT_save_mainfile(wmOperatorType *ot)
                          "Save the current Blender file with a numerically incremented name that "
                          "does not overwrite any existing files");
   RNA_def_property_flag(prop, PropertyFlag(PROP_HIDDEN | PROP_SKIP_SAVE));
+
+  wm_save_mainfile_chunk_store_property(ot);
 }
 
 /** \} */
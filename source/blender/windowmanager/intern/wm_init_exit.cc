@@ -114,6 +114,8 @@
 
 #include "DRW_engine.hh"
 
+#include "NOD_geometry_nodes_profile.hh"
+
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_OPERATORS, "wm.operator");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_HANDLERS, "wm.handler");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_EVENTS, "wm.event");
@@ -591,6 +593,8 @@ void WM_exit_ex(bContext *C, const bool do_python_exit, const bool do_user_exit_
 
   bke::subdiv::exit();
 
+  nodes::geo_eval_log::profile_write();
+
   if (gpu_is_init) {
     BKE_image_free_unused_gpu_textures();
   }
@@ -70,6 +70,7 @@
 #  endif
 
 #  include "DEG_depsgraph.hh"
+#  include "DEG_depsgraph_debug.hh"
 
 #  include "WM_types.hh"
 
@@ -746,8 +747,10 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-tag");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-no-threads");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-memory");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-trace");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
@@ -764,6 +767,7 @@ static void print_help(bArgs *ba, bool all)
   }
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+  BLI_args_print_arg_doc(ba, "--profile-geometry-nodes");
 
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -1299,6 +1303,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_tag[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_time[] =
     "\n\t"
     "Enable debug messages from dependency graph related on timing.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_memory[] =
+    "\n\t"
+    "Enable statistics about the memory used by evaluated data of the dependency graph.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_eval[] =
     "\n\t"
     "Enable debug messages from dependency graph related on evaluation.";
@@ -1321,9 +1328,43 @@ static int arg_handle_debug_mode_generic_set(int /*argc*/, const char ** /*argv*
   return 0;
 }
 
+static const char arg_handle_debug_depsgraph_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the evaluation of all dependency graph operations and write it to <filepath>\n"
+    "\ton exit, in the Chrome trace-event JSON format (for 'chrome://tracing' or Perfetto).";
+static int arg_handle_debug_depsgraph_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  if (argc > 1) {
+    char filepath[FILE_MAX];
+    STRNCPY(filepath, argv[1]);
+    BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+    DEG_debug_trace_begin(filepath);
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a file path after '--debug-depsgraph-trace'.\n");
+  return 0;
+}
+
+static const char arg_handle_profile_geometry_nodes_set_doc[] =
+    "<filepath>\n"
+    "\tGather statistics about every geometry node (time, time waiting for inputs, output sizes)\n"
+    "\tover all evaluations and write them to <filepath> on exit,\n"
+    "\tas JSON if the file name ends with '.json', as CSV otherwise.";
+static int arg_handle_profile_geometry_nodes_set(int argc, const char **argv, void * /*data*/)
+{
+  if (argc > 1) {
+    STRNCPY(G.filepath_geometry_nodes_profile, argv[1]);
+    BLI_path_abs_from_cwd(G.filepath_geometry_nodes_profile,
+                          sizeof(G.filepath_geometry_nodes_profile));
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a file path after '--profile-geometry-nodes'.\n");
+  return 0;
+}
+
 static const char arg_handle_debug_mode_io_doc[] =
     "\n\t"
-    "Enable debug messages for I/O (Collada, ...).";
+    "Enable debug messages for I/O (Collada, blend-file reading statistics, ...).";
 static int arg_handle_debug_mode_io(int /*argc*/, const char ** /*argv*/, void * /*data*/)
 {
   G.debug |= G_DEBUG_IO;
@@ -2729,6 +2770,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--debug-all", CB(arg_handle_debug_mode_all), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--profile-geometry-nodes",
+               CB(arg_handle_profile_geometry_nodes_set),
+               nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-fpe", CB(arg_handle_debug_fpe_set), nullptr);
 
@@ -2788,6 +2834,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_time),
                (void *)G_DEBUG_DEPSGRAPH_TIME);
   BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-memory",
+               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_memory),
+               (void *)G_DEBUG_DEPSGRAPH_MEMORY);
+  BLI_args_add(ba,
 
                nullptr,
                "--debug-depsgraph-no-threads",
@@ -2803,6 +2854,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uid),
                (void *)G_DEBUG_DEPSGRAPH_UID);
+  BLI_args_add(
+      ba, nullptr, "--debug-depsgraph-trace", CB(arg_handle_debug_depsgraph_trace_set), nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",
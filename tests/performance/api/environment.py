@@ -281,6 +281,23 @@ class TestEnvironment:
             filepaths.append(pathlib.Path(filename))
         return filepaths
 
+    def ensure_generated_blend_file(self,
+                                    dirname: str,
+                                    name: str,
+                                    function: Callable[[Dict], Dict],
+                                    args: Dict) -> pathlib.Path:
+        # Generate a blend-file by running the function in Blender, which saves
+        # it to args['filepath']. The file is generated once by the first
+        # revision that needs it, so that all revisions use the same data.
+        dirpath = self.base_dir / dirname
+        filepath = dirpath / (name + '.blend')
+        if not filepath.exists():
+            dirpath.mkdir(parents=True, exist_ok=True)
+            self.run_in_blender(function, dict(args, filepath=str(filepath)))
+            if not filepath.exists():
+                raise Exception(f"Failed to generate {filepath}")
+        return filepath
+
     def get_config_names(self) -> List:
         names = []
 
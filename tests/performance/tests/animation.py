@@ -27,6 +27,48 @@ def _run(args):
     return result
 
 
+def _generate_armature_crowd(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+    scene.frame_start = 1
+    scene.frame_end = 48
+
+    # One armature with a chain of bones, each animated by the same Action.
+    armature = bpy.data.armatures.new("Armature")
+    template = bpy.data.objects.new("Armature", armature)
+    scene.collection.objects.link(template)
+    bpy.context.view_layer.objects.active = template
+    bpy.ops.object.mode_set(mode='EDIT')
+    parent = None
+    for i in range(args['bones']):
+        bone = armature.edit_bones.new(f"Bone{i}")
+        bone.head = (0.0, 0.0, i * 0.1)
+        bone.tail = (0.0, 0.0, (i + 1) * 0.1)
+        bone.parent = parent
+        bone.use_connect = parent is not None
+        parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    for pose_bone in template.pose.bones:
+        pose_bone.rotation_mode = 'XYZ'
+        for frame, angle in ((scene.frame_start, -0.1), (scene.frame_end, 0.1)):
+            pose_bone.rotation_euler = (angle, 0.0, angle)
+            pose_bone.location = (0.0, angle, 0.0)
+            pose_bone.keyframe_insert("rotation_euler", frame=frame)
+            pose_bone.keyframe_insert("location", frame=frame)
+
+    # Copies share the armature and the Action.
+    for i in range(1, args['count']):
+        ob = template.copy()
+        ob.location = (i % 25, i // 25, 0.0)
+        scene.collection.objects.link(ob)
+
+    bpy.ops.wm.save_as_mainfile(filepath=args['filepath'])
+    return {}
+
+
 class AnimationTest(api.Test):
     def __init__(self, filepath):
         self.filepath = filepath
@@ -43,6 +85,38 @@ class AnimationTest(api.Test):
         return result
 
 
+class AnimationSyntheticTest(api.Test):
+    """
+    Play back animation of a blend-file generated locally, to measure specific parts of the
+    animation evaluation without depending on the benchmark files.
+
+    The file is generated once by the first revision running the test, so that all revisions
+    play back the same data.
+    """
+
+    def __init__(self, name, generate_function, args):
+        self.name_ = name
+        self.generate_function = generate_function
+        self.args = args
+
+    def name(self):
+        return self.name_
+
+    def category(self):
+        return "animation"
+
+    def run(self, env, device_id):
+        filepath = env.ensure_generated_blend_file(
+            'animation_synthetic', self.name_, self.generate_function, self.args)
+        result, _ = env.run_in_blender(_run, {}, [filepath])
+        return result
+
+
 def generate(env):
     filepaths = env.find_blend_files('animation/*')
-    return [AnimationTest(filepath) for filepath in filepaths]
+    tests = [AnimationTest(filepath) for filepath in filepaths]
+    tests += [
+        AnimationSyntheticTest("synthetic_armature_crowd", _generate_armature_crowd,
+                               {'count': 500, 'bones': 300}),
+    ]
+    return tests
@@ -3,6 +3,13 @@
 # SPDX-License-Identifier: Apache-2.0
 
 import api
+import re
+
+# Statistics printed for each stage of reading a blend-file with `--debug-io`.
+PHASE_RE = re.compile(r"^Blend-file read phase (\w+): ([0-9.]+)s, (\d+) bytes read, "
+                      r"(-?\d+) bytes allocated, (-?\d+) blocks")
+# Stages interleaved with others, for which no memory statistics are gathered.
+PHASES_INTERLEAVED = {'bhead_scan', 'read_struct'}
 
 
 def _run(filepath):
@@ -13,15 +20,82 @@ def _run(filepath):
     bpy.ops.wm.open_mainfile(filepath=filepath)
     bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
 
-    # Measure loading the second time
+    # Measure loading the second time, only printing the per-phase statistics for this one.
+    bpy.app.debug_io = True
     start_time = time.time()
     bpy.ops.wm.open_mainfile(filepath=filepath)
     elapsed_time = time.time() - start_time
+    bpy.app.debug_io = False
 
     result = {'time': elapsed_time}
     return result
 
 
+def _parse_phases(result, lines):
+    for line in lines:
+        match = PHASE_RE.match(line.strip())
+        if not match:
+            continue
+        phase = match.group(1)
+        result['time_' + phase] = float(match.group(2))
+        result['bytes_read_' + phase] = int(match.group(3))
+        if phase not in PHASES_INTERLEAVED:
+            result['memory_' + phase] = int(match.group(4))
+            result['allocations_' + phase] = int(match.group(5))
+    return result
+
+
+def _generate_many_ids(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+
+    bpy.ops.mesh.primitive_cube_add()
+    cube = bpy.context.object
+    for i in range(args['count']):
+        ob = bpy.data.objects.new(f"Object{i}", cube.data.copy())
+        ob.location = (i % 100, i // 100, 0.0)
+        scene.collection.objects.link(ob)
+
+    bpy.ops.wm.save_as_mainfile(filepath=args['filepath'])
+    return {}
+
+
+def _generate_large_mesh(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    size = args['size']
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=size, y_subdivisions=size)
+
+    bpy.ops.wm.save_as_mainfile(filepath=args['filepath'])
+    return {}
+
+
+def _generate_many_nodes(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    for i in range(args['count']):
+        group = bpy.data.node_groups.new(f"Group{i}", 'GeometryNodeTree')
+        group.interface.new_socket("Value", in_out='OUTPUT', socket_type='NodeSocketFloat')
+        output_node = group.nodes.new('NodeGroupOutput')
+        socket = None
+        for j in range(args['nodes']):
+            node = group.nodes.new('ShaderNodeMath')
+            node.location = (j * 200.0, 0.0)
+            if socket:
+                group.links.new(socket, node.inputs[0])
+            socket = node.outputs[0]
+        group.links.new(socket, output_node.inputs[0])
+        group.use_fake_user = True
+
+    bpy.ops.wm.save_as_mainfile(filepath=args['filepath'])
+    return {}
+
+
 class BlendLoadTest(api.Test):
     def __init__(self, filepath):
         self.filepath = filepath
@@ -33,10 +107,43 @@ class BlendLoadTest(api.Test):
         return "blend_load"
 
     def run(self, env, device_id):
-        result, _ = env.run_in_blender(_run, str(self.filepath))
-        return result
+        result, lines = env.run_in_blender(_run, str(self.filepath))
+        return _parse_phases(result, lines)
+
+
+class BlendLoadSyntheticTest(api.Test):
+    """
+    Load a large blend-file generated locally, to measure specific parts of the file reading
+    without depending on the benchmark files.
+
+    The file is generated once by the first revision running the test, so that all revisions
+    load the same data.
+    """
+
+    def __init__(self, name, generate_function, args):
+        self.name_ = name
+        self.generate_function = generate_function
+        self.args = args
+
+    def name(self):
+        return self.name_
+
+    def category(self):
+        return "blend_load"
+
+    def run(self, env, device_id):
+        filepath = env.ensure_generated_blend_file(
+            'blend_load_synthetic', self.name_, self.generate_function, self.args)
+        result, lines = env.run_in_blender(_run, str(filepath))
+        return _parse_phases(result, lines)
 
 
 def generate(env):
     filepaths = env.find_blend_files('*/*')
-    return [BlendLoadTest(filepath) for filepath in filepaths]
+    tests = [BlendLoadTest(filepath) for filepath in filepaths]
+    tests += [
+        BlendLoadSyntheticTest("synthetic_many_ids", _generate_many_ids, {'count': 20000}),
+        BlendLoadSyntheticTest("synthetic_large_mesh", _generate_large_mesh, {'size': 2000}),
+        BlendLoadSyntheticTest("synthetic_many_nodes", _generate_many_nodes, {'count': 200, 'nodes': 100}),
+    ]
+    return tests
@@ -95,6 +95,47 @@ class TestBlendFileSavePartial(TestHelper):
         assert bpy.data.meshes[self.UNUSED_MESH_NAME].users == 0
 
 
+class TestBlendFileSaveLoadChunkStore(TestHelper):
+
+    def __init__(self, args):
+        self.args = args
+
+    def test_save_load(self):
+        import shutil
+
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+        # Large enough for the position array to be stored in the chunk store.
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=200, y_subdivisions=200)
+        mesh = bpy.context.active_object.data
+        orig_positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", orig_positions)
+
+        output_dir = self.args.output_dir
+        self.ensure_path(output_dir)
+        output_path = os.path.join(output_dir, "blendfile_io_chunk_store.blend")
+        output_path_plain = os.path.join(output_dir, "blendfile_io_chunk_store_plain.blend")
+        store_dir = os.path.join(output_dir, "blendfile_io_chunk_store")
+        shutil.rmtree(store_dir, ignore_errors=True)
+
+        bpy.ops.wm.save_as_mainfile(filepath=output_path_plain, check_existing=False, compress=False, copy=True)
+        bpy.ops.wm.save_as_mainfile(
+            filepath=output_path, check_existing=False, compress=False, chunk_store_directory=store_dir)
+        assert os.path.getsize(output_path) < os.path.getsize(output_path_plain)
+        assert any(files for _, _, files in os.walk(store_dir))
+
+        # Saving again does not add chunks for unchanged data.
+        chunks_num = sum(len(files) for _, _, files in os.walk(store_dir))
+        bpy.ops.wm.save_as_mainfile(
+            filepath=output_path, check_existing=False, compress=False, chunk_store_directory=store_dir)
+        assert chunks_num == sum(len(files) for _, _, files in os.walk(store_dir))
+
+        bpy.ops.wm.open_mainfile(filepath=output_path, load_ui=False)
+        mesh = bpy.data.meshes[0]
+        read_positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", read_positions)
+        assert orig_positions == read_positions
+
+
 # NOTE: Technically this should rather be in `bl_id_management.py` test, but that file uses `unittest` module,
 #       which makes mixing it with tests system used here and passing extra parameters complicated.
 #       Since the main effect of 'RUNTIME' ID tag is on file save, it can as well be here for now.
@@ -192,6 +233,7 @@ class TestIdRuntimeTag(TestHelper):
 TESTS = (
     TestBlendFileSaveLoadBasic,
     TestBlendFileSavePartial,
+    TestBlendFileSaveLoadChunkStore,
 
     TestIdRuntimeTag,
 )
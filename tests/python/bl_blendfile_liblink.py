@@ -793,6 +793,38 @@ class TestBlendLibDataLibrariesLoadLibOverride(TestBlendLibDataLibrariesLoad):
         assert bpy.data.collections[1].override_library.reference == bpy.data.collections[-1]
 
 
+class TestBlendLibDataLibrariesLoadIndex(TestBlendLibDataLibrariesLoad):
+
+    @staticmethod
+    def reset_blender():
+        TestBlendLibDataLibrariesLoad.reset_blender()
+        bpy.context.preferences.experimental.use_blend_file_index = True
+
+    def test_libload_index(self):
+        try:
+            output_lib_path = self.do_libload_init()
+            # The first load creates the index, the second one reads it.
+            for _ in range(2):
+                with bpy.data.libraries.load(filepath=output_lib_path, link=True) as (lib_src, lib_link):
+                    assert lib_src.meshes == ["LibMesh"]
+                    assert lib_src.objects == ["LibMesh"]
+                    assert lib_src.collections == ["LibMesh"]
+                    lib_link.collections.append(lib_src.collections[0])
+                assert len(bpy.data.collections) == 1
+                assert bpy.data.collections[0].library is not None
+                self.reset_blender()
+
+            # Changing the library invalidates its index.
+            bpy.ops.wm.open_mainfile(filepath=output_lib_path)
+            bpy.data.meshes.new("LibMeshNew").use_fake_user = True
+            bpy.ops.wm.save_as_mainfile(filepath=output_lib_path, check_existing=False, compress=False)
+            self.reset_blender()
+            with bpy.data.libraries.load(filepath=output_lib_path) as (lib_src, lib_link):
+                assert sorted(lib_src.meshes) == ["LibMesh", "LibMeshNew"]
+        finally:
+            bpy.context.preferences.experimental.use_blend_file_index = False
+
+
 TESTS = (
     TestBlendLibLinkSaveLoadBasic,
     TestBlendLibLinkAnimation,
@@ -807,6 +839,7 @@ TESTS = (
     TestBlendLibDataLibrariesLoadAppend,
     TestBlendLibDataLibrariesLoadLink,
     TestBlendLibDataLibrariesLoadLibOverride,
+    TestBlendLibDataLibrariesLoadIndex,
 )
 
 
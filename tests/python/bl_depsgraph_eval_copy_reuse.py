@@ -0,0 +1,106 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import math
+import unittest
+
+import bpy
+
+"""
+blender -b --factory-startup --python tests/python/bl_depsgraph_eval_copy_reuse.py
+"""
+
+
+class EvalCopyReuseTest(unittest.TestCase):
+    """
+    The pose and modifiers of evaluated objects are kept when the objects are only moved, and must
+    be copied from the original again on any other change.
+    """
+
+    def setUp(self):
+        bpy.ops.wm.read_homefile(use_factory_startup=True, use_empty=True)
+        scene = bpy.context.scene
+
+        armature = bpy.data.armatures.new("Armature")
+        self.rig = bpy.data.objects.new("Rig", armature)
+        scene.collection.objects.link(self.rig)
+        bpy.context.view_layer.objects.active = self.rig
+        bpy.ops.object.mode_set(mode='EDIT')
+        parent = None
+        for i in range(3):
+            bone = armature.edit_bones.new(f"Bone{i}")
+            bone.head = (0.0, 0.0, float(i))
+            bone.tail = (0.0, 0.0, float(i + 1))
+            bone.parent = parent
+            bone.use_connect = parent is not None
+            parent = bone
+        bpy.ops.object.mode_set(mode='OBJECT')
+        self.rig.pose.bones["Bone0"].rotation_mode = 'XYZ'
+        self.rig.pose.bones["Bone0"].rotation_euler = (0.0, 0.5, 0.0)
+
+        bpy.ops.mesh.primitive_cube_add()
+        self.ob = bpy.context.active_object
+        subdivision = self.ob.modifiers.new("Subdivision", 'SUBSURF')
+        subdivision.levels = 1
+        array = self.ob.modifiers.new("Array", 'ARRAY')
+        array.count = 2
+
+    @staticmethod
+    def _evaluated(ob):
+        return ob.evaluated_get(bpy.context.evaluated_depsgraph_get())
+
+    def _evaluated_pose_matrices(self):
+        return [bone.matrix.copy() for bone in self._evaluated(self.rig).pose.bones]
+
+    def _evaluated_mesh_state(self):
+        ob_eval = self._evaluated(self.ob)
+        mesh = ob_eval.data
+        positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", positions)
+        return [modifier.levels if modifier.type == 'SUBSURF' else modifier.count
+                for modifier in ob_eval.modifiers], positions
+
+    def test_transform_then_geometry_update(self):
+        pose_matrices = self._evaluated_pose_matrices()
+        modifier_settings, positions = self._evaluated_mesh_state()
+        self.assertEqual(modifier_settings, [1, 2])
+
+        # Only the transforms are tagged, the evaluated pose and modifiers are kept.
+        self.rig.location = (2.0, 0.0, 0.0)
+        self.ob.location = (0.0, 3.0, 0.0)
+        self.assertEqual(self._evaluated_pose_matrices(), pose_matrices)
+        self.assertEqual(self._evaluated_mesh_state(), (modifier_settings, positions))
+        self.assertEqual(self._evaluated(self.rig).matrix_world.translation[:], (2.0, 0.0, 0.0))
+        self.assertEqual(self._evaluated(self.ob).matrix_world.translation[:], (0.0, 3.0, 0.0))
+
+        # Changes of the pose and modifiers are tagged as geometry changes, they must be copied.
+        self.rig.pose.bones["Bone0"].rotation_euler = (0.0, 0.0, 0.0)
+        self.ob.modifiers["Subdivision"].levels = 2
+        self.ob.modifiers["Array"].count = 3
+        self.assertNotEqual(self._evaluated_pose_matrices(), pose_matrices)
+        rig_eval = self._evaluated(self.rig)
+        self.assertEqual(rig_eval.pose.bones["Bone0"].rotation_euler[:], (0.0, 0.0, 0.0))
+        modifier_settings, positions_changed = self._evaluated_mesh_state()
+        self.assertEqual(modifier_settings, [2, 3])
+        self.assertNotEqual(len(positions), len(positions_changed))
+
+    def test_transform_and_geometry_update(self):
+        self._evaluated_pose_matrices()
+        self._evaluated_mesh_state()
+
+        # Both are tagged before the depsgraph is evaluated.
+        self.rig.location = (2.0, 0.0, 0.0)
+        self.rig.pose.bones["Bone0"].rotation_euler = (0.0, math.pi / 2.0, 0.0)
+        self.ob.location = (0.0, 3.0, 0.0)
+        self.ob.modifiers["Array"].count = 3
+        rig_eval = self._evaluated(self.rig)
+        self.assertAlmostEqual(
+            rig_eval.pose.bones["Bone0"].rotation_euler.y, math.pi / 2.0, places=5)
+        self.assertEqual(self._evaluated_mesh_state()[0], [1, 3])
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -0,0 +1,98 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import unittest
+
+import bpy
+
+"""
+blender -b --factory-startup --python tests/python/bl_depsgraph_relations_update.py
+"""
+
+
+class IncrementalRelationsUpdateTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_homefile(use_factory_startup=True, use_empty=True)
+        bpy.context.preferences.view.show_developer_ui = True
+
+    def tearDown(self):
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = False
+        bpy.context.preferences.view.show_developer_ui = False
+
+    @staticmethod
+    def _add_displaced_grid(name, texture, location):
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=16, y_subdivisions=16, location=location)
+        ob = bpy.context.active_object
+        ob.name = name
+        modifier = ob.modifiers.new("Displace", 'DISPLACE')
+        modifier.texture = texture
+        return ob
+
+    @staticmethod
+    def _evaluated_positions(ob):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        mesh = ob.evaluated_get(depsgraph).data
+        positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", positions)
+        return positions
+
+    @staticmethod
+    def _evaluated_id_names():
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        return {id.name for id in depsgraph.ids}
+
+    def _check_shared_texture_after_other_user_changes_texture(self):
+        texture_a = bpy.data.textures.new("TextureA", 'CLOUDS')
+        texture_b = bpy.data.textures.new("TextureB", 'CLOUDS')
+        ob_first = self._add_displaced_grid("First", texture_a, (0.0, 0.0, 0.0))
+        ob_second = self._add_displaced_grid("Second", texture_a, (3.0, 0.0, 0.0))
+        # Texture B is already in the graph, so the first object can be updated on its own.
+        self._add_displaced_grid("Third", texture_b, (6.0, 0.0, 0.0))
+        self._evaluated_positions(ob_second)
+
+        ob_first.modifiers["Displace"].texture = texture_b
+        self._evaluated_positions(ob_first)
+
+        # The second object still depends on the texture the first object stopped using.
+        positions_first = self._evaluated_positions(ob_first)
+        positions_before = self._evaluated_positions(ob_second)
+        texture_a.noise_scale *= 2.0
+        self.assertNotEqual(positions_before, self._evaluated_positions(ob_second))
+        # The first object doesn't depend on it anymore.
+        self.assertEqual(positions_first, self._evaluated_positions(ob_first))
+
+        # The first object depends on its new texture.
+        texture_b.noise_scale *= 2.0
+        self.assertNotEqual(positions_first, self._evaluated_positions(ob_first))
+
+    def test_shared_texture_after_other_user_changes_texture(self):
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = True
+        self._check_shared_texture_after_other_user_changes_texture()
+
+    def test_shared_texture_after_other_user_changes_texture_full_update(self):
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = False
+        self._check_shared_texture_after_other_user_changes_texture()
+
+    def test_unused_nodes_are_kept(self):
+        texture_a = bpy.data.textures.new("TextureA", 'CLOUDS')
+        texture_b = bpy.data.textures.new("TextureB", 'CLOUDS')
+        ob_first = self._add_displaced_grid("First", texture_a, (0.0, 0.0, 0.0))
+        self._add_displaced_grid("Second", texture_b, (3.0, 0.0, 0.0))
+        self.assertIn(texture_a.name_full, self._evaluated_id_names())
+
+        # Only the relations of the first object are updated, the nodes of the texture it stopped
+        # using are not removed. Rebuilding the whole graph removes them.
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = True
+        ob_first.modifiers["Displace"].texture = texture_b
+        self.assertIn(texture_a.name_full, self._evaluated_id_names())
+
+        bpy.context.preferences.experimental.use_depsgraph_incremental_relations = False
+        ob_first.modifiers["Displace"].texture = texture_b
+        self.assertNotIn(texture_a.name_full, self._evaluated_id_names())
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -0,0 +1,115 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import time
+import unittest
+
+import bpy
+
+"""
+blender -b --factory-startup --python tests/python/bl_geometry_nodes_memoization.py
+"""
+
+
+class GeometryNodesMemoizationTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_homefile(use_factory_startup=True, use_empty=True)
+        bpy.context.preferences.view.show_developer_ui = True
+        bpy.context.preferences.experimental.no_geometry_nodes_memoization = False
+
+        tree = bpy.data.node_groups.new("Memoization", 'GeometryNodeTree')
+        tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+        sphere = tree.nodes.new('GeometryNodeMeshUVSphere')
+        # Creates an empty mesh and an info warning.
+        cylinder = tree.nodes.new('GeometryNodeMeshCylinder')
+        cylinder.inputs["Vertices"].default_value = 2
+        self.set_position = tree.nodes.new('GeometryNodeSetPosition')
+        join = tree.nodes.new('GeometryNodeJoinGeometry')
+        output = tree.nodes.new('NodeGroupOutput')
+        tree.links.new(sphere.outputs["Mesh"], self.set_position.inputs["Geometry"])
+        tree.links.new(self.set_position.outputs["Geometry"], join.inputs["Geometry"])
+        tree.links.new(cylinder.outputs["Mesh"], join.inputs["Geometry"])
+        tree.links.new(join.outputs["Geometry"], output.inputs["Geometry"])
+
+        self.ob = bpy.data.objects.new("Object", bpy.data.meshes.new("Mesh"))
+        bpy.context.scene.collection.objects.link(self.ob)
+        self.modifier = self.ob.modifiers.new("Nodes", 'NODES')
+        self.modifier.node_group = tree
+
+    def tearDown(self):
+        bpy.context.preferences.experimental.no_geometry_nodes_memoization = False
+        bpy.context.preferences.view.show_developer_ui = False
+
+    def _evaluated_positions(self):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        mesh = self.ob.evaluated_get(depsgraph).data
+        positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", positions)
+        return positions
+
+    def _warning_messages(self):
+        return [warning.message for warning in self.modifier.node_warnings]
+
+    def test_reuse_outputs(self):
+        positions = self._evaluated_positions()
+        warnings = self._warning_messages()
+        self.assertIn("Vertices must be at least 3", warnings)
+
+        # Only the Set Position node changes, the outputs of the primitives are reused.
+        self.set_position.inputs["Offset"].default_value = (0.0, 0.0, 1.0)
+        positions_offset = self._evaluated_positions()
+        self.assertEqual(len(positions), len(positions_offset))
+        for i in range(0, len(positions), 3):
+            self.assertAlmostEqual(positions[i + 2] + 1.0, positions_offset[i + 2], places=5)
+        # The warnings of nodes that are not executed again are logged from the cache.
+        self.assertEqual(warnings, self._warning_messages())
+
+        # The result does not depend on memoization.
+        bpy.context.preferences.experimental.no_geometry_nodes_memoization = True
+        self.set_position.inputs["Offset"].default_value = (0.0, 0.0, 0.0)
+        self.assertEqual(positions, self._evaluated_positions())
+        self.assertEqual(warnings, self._warning_messages())
+
+    def _evaluation_time(self):
+        start_time = time.perf_counter()
+        bpy.context.evaluated_depsgraph_get()
+        return time.perf_counter() - start_time
+
+    def test_reuse_skips_execution(self):
+        tree = self.modifier.node_group
+        tree.nodes.clear()
+        sphere = tree.nodes.new('GeometryNodeMeshUVSphere')
+        sphere.inputs["Segments"].default_value = 128
+        sphere.inputs["Rings"].default_value = 64
+        subdivide = tree.nodes.new('GeometryNodeSubdivisionSurface')
+        subdivide.inputs["Level"].default_value = 3
+        # Changing the points only changes a component that is joined with the memoized mesh.
+        points = tree.nodes.new('GeometryNodePoints')
+        join = tree.nodes.new('GeometryNodeJoinGeometry')
+        output = tree.nodes.new('NodeGroupOutput')
+        tree.links.new(sphere.outputs["Mesh"], subdivide.inputs["Mesh"])
+        tree.links.new(subdivide.outputs["Mesh"], join.inputs["Geometry"])
+        tree.links.new(points.outputs["Geometry"], join.inputs["Geometry"])
+        tree.links.new(join.outputs["Geometry"], output.inputs["Geometry"])
+        self._evaluation_time()
+
+        def min_evaluation_time():
+            times = []
+            for _ in range(3):
+                points.inputs["Count"].default_value += 1
+                times.append(self._evaluation_time())
+            return min(times)
+
+        time_reused = min_evaluation_time()
+        bpy.context.preferences.experimental.no_geometry_nodes_memoization = True
+        time_executed = min_evaluation_time()
+        # Subdividing the mesh takes much longer than the rest of the evaluation, the margin keeps
+        # the test from depending on the machine or build type.
+        self.assertLess(time_reused * 4.0, time_executed)
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -0,0 +1,151 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+import unittest
+
+import bpy
+
+"""
+blender -b --factory-startup --python tests/python/bl_geometry_nodes_zones.py
+"""
+
+
+class GeometryNodesZonesTest(unittest.TestCase):
+    def setUp(self):
+        bpy.ops.wm.read_homefile(use_factory_startup=True, use_empty=True)
+        self.tree = bpy.data.node_groups.new("Zones", 'GeometryNodeTree')
+        self.tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+        self.group_output = self.tree.nodes.new('NodeGroupOutput')
+
+        self.ob = bpy.data.objects.new("Object", bpy.data.meshes.new("Mesh"))
+        bpy.context.scene.collection.objects.link(self.ob)
+        modifier = self.ob.modifiers.new("Nodes", 'NODES')
+        modifier.node_group = self.tree
+
+    def _evaluated_mesh(self):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        return self.ob.evaluated_get(depsgraph).data
+
+    def _evaluated_positions(self):
+        mesh = self._evaluated_mesh()
+        positions = [0.0] * len(mesh.vertices) * 3
+        mesh.vertices.foreach_get("co", positions)
+        return positions
+
+    def _new_node(self, idname, **inputs):
+        node = self.tree.nodes.new(idname)
+        for name, value in inputs.items():
+            node.inputs[name].default_value = value
+        return node
+
+    def _add_repeat_body(self, iteration, geometry):
+        """
+        Add nodes computing one iteration of the repeat zone body, return the resulting geometry.
+        """
+        links = self.tree.links
+
+        # Nodes that compute the same values in every iteration.
+        line = self._new_node('GeometryNodeMeshLine', Count=5)
+        bounding_box = self.tree.nodes.new('GeometryNodeBoundingBox')
+        links.new(line.outputs["Mesh"], bounding_box.inputs["Geometry"])
+        factor = self.tree.nodes.new('ShaderNodeMath')
+        factor.operation = 'MULTIPLY'
+        factor.inputs[0].default_value = 2.0
+        factor.inputs[1].default_value = 3.0
+
+        # The maximum of the bounding box is not used in the first iteration.
+        is_first = self.tree.nodes.new('ShaderNodeMath')
+        is_first.operation = 'GREATER_THAN'
+        links.new(iteration, is_first.inputs[0])
+        is_first.inputs[1].default_value = 0.0
+        switch = self.tree.nodes.new('GeometryNodeSwitch')
+        switch.input_type = 'VECTOR'
+        links.new(is_first.outputs[0], switch.inputs["Switch"])
+        links.new(bounding_box.outputs["Min"], switch.inputs["False"])
+        links.new(bounding_box.outputs["Max"], switch.inputs["True"])
+
+        # Nodes that depend on the iteration.
+        transform = self.tree.nodes.new('GeometryNodeTransform')
+        links.new(line.outputs["Mesh"], transform.inputs["Geometry"])
+        links.new(switch.outputs[0], transform.inputs["Translation"])
+        offset = self.tree.nodes.new('ShaderNodeCombineXYZ')
+        links.new(iteration, offset.inputs["X"])
+        links.new(factor.outputs[0], offset.inputs["Y"])
+        set_line_position = self.tree.nodes.new('GeometryNodeSetPosition')
+        links.new(transform.outputs["Geometry"], set_line_position.inputs["Geometry"])
+        links.new(offset.outputs[0], set_line_position.inputs["Offset"])
+
+        # Nodes that depend on the repeat item, including a captured attribute.
+        capture = self.tree.nodes.new('GeometryNodeCaptureAttribute')
+        capture.capture_items.new('VECTOR', "Position")
+        links.new(geometry, capture.inputs["Geometry"])
+        links.new(self.tree.nodes.new('GeometryNodeInputPosition').outputs[0], capture.inputs["Position"])
+        lift = self.tree.nodes.new('ShaderNodeVectorMath')
+        lift.operation = 'ADD'
+        links.new(capture.outputs["Position"], lift.inputs[0])
+        lift.inputs[1].default_value = (0.0, 0.0, 1.0)
+        set_position = self.tree.nodes.new('GeometryNodeSetPosition')
+        links.new(capture.outputs["Geometry"], set_position.inputs["Geometry"])
+        links.new(lift.outputs["Vector"], set_position.inputs["Position"])
+
+        join = self.tree.nodes.new('GeometryNodeJoinGeometry')
+        links.new(set_position.outputs["Geometry"], join.inputs["Geometry"])
+        links.new(set_line_position.outputs["Geometry"], join.inputs["Geometry"])
+        return join.outputs["Geometry"]
+
+    def test_repeat_zone_invariant_nodes(self):
+        iterations = 4
+
+        repeat_input = self._new_node('GeometryNodeRepeatInput', Iterations=iterations)
+        repeat_output = self.tree.nodes.new('GeometryNodeRepeatOutput')
+        repeat_input.pair_with_output(repeat_output)
+        body_result = self._add_repeat_body(
+            repeat_input.outputs["Iteration"], repeat_input.outputs["Geometry"])
+        self.tree.links.new(body_result, repeat_output.inputs["Geometry"])
+        self.tree.links.new(repeat_output.outputs["Geometry"], self.group_output.inputs["Geometry"])
+        positions = self._evaluated_positions()
+        self.assertEqual(len(positions), 5 * iterations * 3)
+
+        # The same nodes without a repeat zone, so nothing can be reused between iterations.
+        self.tree.nodes.clear()
+        self.group_output = self.tree.nodes.new('NodeGroupOutput')
+        geometry = self.tree.nodes.new('GeometryNodeJoinGeometry').outputs["Geometry"]
+        for i in range(iterations):
+            iteration = self._new_node('FunctionNodeInputInt')
+            iteration.integer = i
+            geometry = self._add_repeat_body(iteration.outputs[0], geometry)
+        self.tree.links.new(geometry, self.group_output.inputs["Geometry"])
+        self.assertEqual(positions, self._evaluated_positions())
+
+    def test_foreach_zone_many_elements(self):
+        elements_num = 2000
+
+        line = self._new_node('GeometryNodeMeshLine', Count=elements_num)
+        foreach_input = self.tree.nodes.new('GeometryNodeForeachGeometryElementInput')
+        foreach_output = self.tree.nodes.new('GeometryNodeForeachGeometryElementOutput')
+        foreach_input.pair_with_output(foreach_output)
+        foreach_output.main_items.new('FLOAT', "Value")
+        self.tree.links.new(line.outputs["Mesh"], foreach_input.inputs["Geometry"])
+
+        double = self.tree.nodes.new('ShaderNodeMath')
+        double.operation = 'MULTIPLY'
+        double.inputs[1].default_value = 2.0
+        self.tree.links.new(foreach_input.outputs["Index"], double.inputs[0])
+        self.tree.links.new(double.outputs[0], foreach_output.inputs["Value"])
+
+        store = self._new_node('GeometryNodeStoreNamedAttribute', Name="result")
+        self.tree.links.new(foreach_output.outputs[0], store.inputs["Geometry"])
+        self.tree.links.new(foreach_output.outputs["Value"], store.inputs["Value"])
+        self.tree.links.new(store.outputs["Geometry"], self.group_output.inputs["Geometry"])
+
+        mesh = self._evaluated_mesh()
+        values = [0.0] * elements_num
+        mesh.attributes["result"].data.foreach_get("value", values)
+        self.assertEqual(values, [i * 2.0 for i in range(elements_num)])
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -391,6 +391,56 @@ def view3d_sculpt_with_memfile_step():
     t.assertEqual(mesh_verts_cos, mesh_verts_cos_sculpt_stroke2)
 
 
+def view3d_sculpt_with_memfile_step_skip_unchanged():
+    import bpy
+    e, t = _test_vars(window := _test_window())
+    # Memfile steps reuse the stored data of curves that were not tagged as changed since the
+    # previous step. Curves sculpt strokes are memfile steps themselves and tag the curves.
+    bpy.context.preferences.experimental.use_undo_skip_unchanged_ids = True
+    bpy.context.preferences.experimental.use_new_curves_tools = True
+    yield from _view3d_startup_area_maximized(e)
+
+    yield from _call_menu(e, "Add -> Curve -> Random")
+    yield e.numpad_period()             # View all.
+    yield e.ctrl.tab().s()              # Sculpt via pie menu.
+
+    def extract_curves_positions(window):
+        depsgraph = window.view_layer.depsgraph
+        depsgraph.update()
+        curves = window.view_layer.objects.active.evaluated_get(depsgraph).data
+        positions = [0.0] * len(curves.points) * 3
+        curves.attributes["position"].data.foreach_get("vector", positions)
+        return positions
+
+    positions_before_sculpt = extract_curves_positions(window)
+
+    yield from e.leftmouse.cursor_motion(_cursor_motion_data_x(window))
+    positions_sculpt_stroke1 = extract_curves_positions(window)
+    t.assertNotEqual(positions_before_sculpt, positions_sculpt_stroke1)
+
+    # Add a 'memfile' undo step which doesn't change the curves, their data stored by the stroke
+    # is reused.
+    yield e.f3().text("add const").ret().d()  # Add 'Limit Distance' constraint.
+
+    yield from e.leftmouse.cursor_motion(_cursor_motion_data_y(window))
+    positions_sculpt_stroke2 = extract_curves_positions(window)
+    t.assertNotEqual(positions_sculpt_stroke1, positions_sculpt_stroke2)
+
+    # Undo to the constraint step, the curves are read from the data reused from the first stroke.
+    yield e.ctrl.z()
+    t.assertEqual(extract_curves_positions(window), positions_sculpt_stroke1)
+    yield e.ctrl.z()
+    t.assertEqual(extract_curves_positions(window), positions_sculpt_stroke1)
+    yield e.ctrl.z()
+    t.assertEqual(extract_curves_positions(window), positions_before_sculpt)
+
+    yield e.ctrl.shift.z(3)
+    t.assertEqual(extract_curves_positions(window), positions_sculpt_stroke2)
+
+    bpy.context.preferences.experimental.use_new_curves_tools = False
+    bpy.context.preferences.experimental.use_undo_skip_unchanged_ids = False
+
+
 def view3d_sculpt_dyntopo_simple():
     e, t = _test_vars(window := _test_window())
     yield from _view3d_startup_area_maximized(e)